@@ -0,0 +1,58 @@
+/**
+ * @file   fix_framer.h
+ * @date   Created on: 10/17/2026 10:12:40 AM
+ */
+
+#ifndef FIX_PARSER_FIX_FRAMER_H
+#define FIX_PARSER_FIX_FRAMER_H
+
+#include "fix_types.h"
+#include "fix_parser_dll.h"
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * create new framer instance. Framer splits byte stream into FIX messages, remembering how far it got through
+ * BeginString, BodyLength and CheckSum between calls, so incomplete message is never re-scanned
+ * @param[in] delimiter - FIX SOH
+ * @param[in] maxMsgLen - max allowed message length, including CheckSum field, 0 - unlimited
+ * @return new framer instance, NULL - out of memory
+ */
+FIX_PARSER_API FIXFramer* fix_framer_create(char delimiter, uint32_t maxMsgLen);
+
+/**
+ * free framer instance
+ * @param[in] framer - framer instance
+ */
+FIX_PARSER_API void fix_framer_free(FIXFramer* framer);
+
+/**
+ * forget incomplete message. Must be called after error, before framing of new data
+ * @param[in] framer - framer instance
+ */
+FIX_PARSER_API void fix_framer_reset(FIXFramer* framer);
+
+/**
+ * find next complete message. Data must begin with current message and contain all bytes passed by previous calls,
+ * i.e. caller appends received chunks to the buffer and advances buffer begin only by returned message length
+ * @param[in] framer - framer instance
+ * @param[in] data - buffer, beginning with current message
+ * @param[in] len - length of buffer
+ * @param[out] msgLen - length of complete message, including last delimiter. Message is data[0, msgLen) and can be
+ * passed directly to fix_parser_str_to_msg
+ * @param[out] error - error description, if any. If error is returned it must be destroyed by fix_error_free(error)
+ * @return FIX_SUCCESS - message is complete, FIX_ERROR_NO_MORE_DATA - message is incomplete, no error is allocated,
+ * FIX_FAILED - data is not FIX message, see error
+ */
+FIX_PARSER_API FIXErrCode fix_framer_next(FIXFramer* framer, char const* data, uint32_t len, uint32_t* msgLen, FIXError** error);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FIX_PARSER_FIX_FRAMER_H */
@@ -32,6 +32,15 @@ FIX_PARSER_API FIXMsg* fix_msg_create(FIXParser* parser, char const* msgType, FI
  */
 FIX_PARSER_API void fix_msg_free(FIXMsg* msg);
 
+/**
+ * clear message in place, so it looks like just created one of the same type. Memory pages and groups of message
+ * are kept for reuse, nothing is returned to parser
+ * @param[in] msg - message, which should be cleared
+ * @param[out] error - error description
+ * @return FIX_SUCCESS - ok, FIX_FAILED - see error description
+ */
+FIX_PARSER_API FIXErrCode fix_msg_reset(FIXMsg* msg, FIXError** error);
+
 /**
  * return message type. E.g. "A", "8", "D", etc
  * @param[in] msg - fix message
@@ -145,6 +154,33 @@ FIX_PARSER_API FIXErrCode fix_msg_set_char(FIXMsg* msg, FIXGroup* grp, FIXTagNum
  */
 FIX_PARSER_API FIXErrCode fix_msg_set_double(FIXMsg* msg, FIXGroup* grp, FIXTagNum tagNum, double val, FIXError** error);
 
+/**
+ * set tag with double value, which is formatted with fixed count of decimals, e.g. tick size of price
+ * @param[in] msg - FIX message
+ * @param[in] grp - non NULL group, if tag is a part of group, else must be NULL
+ * @param[in] tagNum - field tag number
+ * @param[in] val - double value
+ * @param[in] precision - count of decimals, at most 17. Value is rounded half away from zero
+ * @param[out] error - error description
+ * @return FIX_SUCCESS - OK, FIX_FAILED - not set. See fix_parser_get_error_code(parser) for details
+ */
+FIX_PARSER_API FIXErrCode fix_msg_set_double_fixed(FIXMsg* msg, FIXGroup* grp, FIXTagNum tagNum, double val, uint32_t precision,
+      FIXError** error);
+
+/**
+ * set tag with scaled decimal value mantissa * 10^exponent, e.g. price 135.10 is (13510, -2). Value is formatted
+ * without floating point, decimals are written as is
+ * @param[in] msg - FIX message
+ * @param[in] grp - non NULL group, if tag is a part of group, else must be NULL
+ * @param[in] tagNum - field tag number
+ * @param[in] mantissa - decimal mantissa
+ * @param[in] exponent - decimal exponent, in range [-18, 18]
+ * @param[out] error - error description
+ * @return FIX_SUCCESS - OK, FIX_FAILED - not set. See fix_parser_get_error_code(parser) for details
+ */
+FIX_PARSER_API FIXErrCode fix_msg_set_decimal(FIXMsg* msg, FIXGroup* grp, FIXTagNum tagNum, int64_t mantissa, int32_t exponent,
+      FIXError** error);
+
 /**
  * set tag with data value
  * @param[in] msg - FIX message
@@ -196,6 +232,21 @@ FIX_PARSER_API FIXErrCode fix_msg_get_int64(FIXMsg* msg, FIXGroup* grp, FIXTagNu
  */
 FIX_PARSER_API FIXErrCode fix_msg_get_double(FIXMsg* msg, FIXGroup* grp, FIXTagNum tagNum, double* val, FIXError** error);
 
+/**
+ * get tag scaled decimal value without floating point, e.g. "135.10" is returned as mantissa 13510 and exponent -2
+ * @param[in] msg - FIX message
+ * @param[in] grp - non NULL group, if tag is a part of group, else must be NULL
+ * @param[in] tagNum - field tag number
+ * @param[out] mantissa - decimal mantissa
+ * @param[out] exponent - decimal exponent, always <= 0
+ * @param[out] error - error description
+ * @return FIX_SUCCESS - OK
+ *         FIX_NO_FIELD - field not found
+ *         FIX_FAILED - error description, e.g. mantissa doesn't fit into int64
+ */
+FIX_PARSER_API FIXErrCode fix_msg_get_decimal(FIXMsg* msg, FIXGroup* grp, FIXTagNum tagNum, int64_t* mantissa,
+      int32_t* exponent, FIXError** error);
+
 /**
  * get tag char value
  * @param[in] msg - FIX message
@@ -18,6 +18,23 @@ extern "C"
 {
 #endif
 
+/**
+ * load FIX protocol description. Description is immutable, so it can be shared by parsers used in different threads
+ * without locking. Each parser owns its own pages, groups and messages, so typical usage is one parser per thread,
+ * all of them created by fix_parser_create_with_protocol with the same description
+ * @param[in] protFile - path to xml file with protocol description
+ * @param[out] error - error description, if any. If error is returned, it must be destroyed by free(error)
+ * @return protocol description, NULL - error. Must be released by fix_protocol_free
+ */
+FIX_PARSER_API FIXProtocolDescr const* fix_protocol_create(char const* protFile, FIXError** error);
+
+/**
+ * release protocol description. Description is destroyed, when it is released by its creator and by all parsers,
+ * which use it. Thread safe
+ * @param[in] prot - protocol description
+ */
+FIX_PARSER_API void fix_protocol_free(FIXProtocolDescr const* prot);
+
 /**
  * create new parser instance
  * @param[in] protFile - path to xml file with protocol description. see fix_parser/fix_descr directory for various FIX
@@ -29,12 +46,32 @@ extern "C"
  */
 FIX_PARSER_API FIXParser* fix_parser_create(char const* protFile, FIXParserAttrs const* attrs, int32_t flags, FIXError** error);
 
+/**
+ * create new parser instance with already loaded protocol description. Parser holds a reference to description, so
+ * description may be released by caller right after this call. Thread safe
+ * @param[in] prot - protocol description, see fix_protocol_create and fix_parser_get_protocol
+ * @param[in] attrs - parser attributes
+ * @param[in] flags - parser flags. See PARSER_FLAG_CHECK_* values
+ * @param[out] error - error description, if any. If error is returned, it must be destroyed by free(error)
+ * @return new instance of FIX parser. if NULL, invoke fix_error_get_code(error), fix_error_get_text(error) for error description
+ */
+FIX_PARSER_API FIXParser* fix_parser_create_with_protocol(FIXProtocolDescr const* prot, FIXParserAttrs const* attrs,
+      int32_t flags, FIXError** error);
+
 /**
  * free parser instance.
  * @param[in] parser - pointer to parser instance
  */
 FIX_PARSER_API void fix_parser_free(FIXParser* parser);
 
+/**
+ * return protocol description of the parser instance. Can be passed to fix_parser_create_with_protocol to create
+ * parsers for other threads
+ * @param[in] parser - pointer to parser instance
+ * @return protocol description, NULL - in case of error
+ */
+FIX_PARSER_API FIXProtocolDescr const* fix_parser_get_protocol(FIXParser* parser);
+
 /**
  * return FIX protocol verision of the parser instance
  * @param[in] parser - pointer to parser instance
@@ -54,6 +91,108 @@ FIX_PARSER_API char const* fix_parser_get_protocol_ver(FIXParser* parser);
  */
 FIX_PARSER_API FIXMsg* fix_parser_str_to_msg(FIXParser* parser, char const* data, uint32_t len, char delimiter, char const** stop, FIXError** error);
 
+/**
+ * parse FIX encoded message without copying field values. Message fields reference data buffer, so buffer must not be
+ * changed or freed until message is destroyed with fix_msg_free. Fields set later by fix_msg_set_* are copied as usual
+ * @param[in] parser - instance of FIX parser
+ * @param[in] data - pointer to data win FIX message
+ * @param[in] len - length of parsed data
+ * @param[in] delimiter - FIX SOH
+ * @param[in] stop - pointer to position in data, where parsing is stopped
+ * @param[out] error - error descritption
+ * @return new instance of parsed message
+ */
+FIX_PARSER_API FIXMsg* fix_parser_str_to_view(FIXParser* parser, char const* data, uint32_t len, char delimiter, char const** stop, FIXError** error);
+
+/**
+ * parse FIX encoded message into existing message. Message is reset before parsing, its pages and groups are reused,
+ * so steady-state receive loop doesn't allocate anything
+ * @param[in] parser - instance of FIX parser, which created msg
+ * @param[in] msg - message, which will hold parsed data. If parsing failed, message is left partially filled and must
+ * be reset or freed
+ * @param[in] data - pointer to data win FIX message
+ * @param[in] len - length of parsed data
+ * @param[in] delimiter - FIX SOH
+ * @param[out] stop - pointer to position in data, where parsing is stopped
+ * @param[out] error - error descritption
+ * @return FIX_SUCCESS - ok, FIX_FAILED - see error description
+ */
+FIX_PARSER_API FIXErrCode fix_parser_str_to_msg_into(FIXParser* parser, FIXMsg* msg, char const* data, uint32_t len,
+      char delimiter, char const** stop, FIXError** error);
+
+/**
+ * parse buffer with several FIX encoded messages, placed one after another. Parsing stops at the end of buffer, when
+ * msgs array is full or at incomplete message in the buffer tail
+ * @param[in] parser - instance of FIX parser
+ * @param[in] data - pointer to data with FIX messages
+ * @param[in] len - length of parsed data
+ * @param[in] delimiter - FIX SOH
+ * @param[out] msgs - array for parsed messages. Each parsed message must be destroyed with fix_msg_free
+ * @param[in] maxMsgs - size of msgs array
+ * @param[out] count - count of parsed messages stored in msgs
+ * @param[out] stop - position of first unparsed byte in data, i.e. begin of incomplete or wrong message
+ * @param[out] error - error description, if any. If error is returned it must be destroyed by fix_error_free(error)
+ * @return FIX_SUCCESS - ok, FIX_FAILED - message at stop position can't be parsed, see error. Messages parsed before it
+ * are returned in msgs anyway
+ */
+FIX_PARSER_API FIXErrCode fix_parser_str_to_msgs(FIXParser* parser, char const* data, uint32_t len, char delimiter,
+      FIXMsg** msgs, uint32_t maxMsgs, uint32_t* count, char const** stop, FIXError** error);
+
+/**
+ * restrict parsing of given message type to set of tags. Parser skips all other fields of such message without storing
+ * them, repeating groups outside the set are skipped entirely. Projection replaces previous one of the same message type
+ * @param[in] parser - instance of FIX parser
+ * @param[in] msgType - message type, e.g. "8"
+ * @param[in] tags - top-level tags of message, which must be parsed. Groups are parsed with all their fields
+ * @param[in] tagCount - count of tags
+ * @param[out] error - error description, if any. If error is returned it must be destroyed by fix_error_free(error)
+ * @return FIX_SUCCESS - ok, FIX_FAILED - unknown message type or tag, see error
+ * @note required fields outside projection are not checked by parser
+ */
+FIX_PARSER_API FIXErrCode fix_parser_set_projection(FIXParser* parser, char const* msgType, FIXTagNum const* tags,
+      uint32_t tagCount, FIXError** error);
+
+/**
+ * remove projection of message type, so all fields of such message are parsed again
+ * @param[in] parser - instance of FIX parser
+ * @param[in] msgType - message type, e.g. "8"
+ * @return FIX_SUCCESS - projection removed, FIX_FAILED - no projection for message type
+ */
+FIX_PARSER_API FIXErrCode fix_parser_reset_projection(FIXParser* parser, char const* msgType);
+
+/**
+ * return memory usage statistics of message type. If FIXParserAttrs::arenaSize is set, these statistics choose size of
+ * the first page of new message of this type
+ * @param[in] parser - instance of FIX parser
+ * @param[in] msgType - message type, e.g. "8"
+ * @param[out] stats - statistics of message type
+ * @param[out] error - error description, if any. If error is returned it must be destroyed by fix_error_free(error)
+ * @return FIX_SUCCESS - ok, FIX_FAILED - unknown message type, see error
+ */
+FIX_PARSER_API FIXErrCode fix_parser_get_msg_stats(FIXParser* parser, char const* msgType, FIXMsgStats* stats,
+      FIXError** error);
+
+/**
+ * return usage statistics of parser pools. Peaks and overflows show how FIXParserAttrs num* and max* values
+ * should be set
+ * @param[in] parser - instance of FIX parser
+ * @param[out] stats - parser statistics
+ * @return FIX_SUCCESS - ok, FIX_FAILED - bad arguments
+ */
+FIX_PARSER_API FIXErrCode fix_parser_get_stats(FIXParser* parser, FIXParserStats* stats);
+
+/**
+ * release free pool objects, until count of allocated (used and free) objects reaches target. Objects preallocated
+ * in slab (see FIXParserAttrs::poolFlags) are never released, so target may be not reached. All free arena blocks
+ * are released as well
+ * @param[in] parser - instance of FIX parser
+ * @param[in] numPages - target count of allocated pages, e.g. FIXParserAttrs::numPages
+ * @param[in] numGroups - target count of allocated groups
+ * @param[in] numMsgs - target count of allocated messages
+ * @return FIX_SUCCESS - ok, FIX_FAILED - bad arguments
+ */
+FIX_PARSER_API FIXErrCode fix_parser_trim(FIXParser* parser, uint32_t numPages, uint32_t numGroups, uint32_t numMsgs);
+
 /**
  * pre-parse string and return pair SenderCompID and TargetCompID
  * @param[in] data - message for pre-parsing
@@ -79,6 +218,24 @@ FIX_PARSER_API FIXErrCode fix_parser_get_header(char const* data, uint32_t len,
       char const** targetCompID, uint32_t* targetCompIDLen,
       int64_t* msgSeqNum, char* possDupFlag, FIXError** error);
 
+/**
+ * pre-parse string and return values of requested tags without parsing the whole message. Nothing is allocated,
+ * if no error occurred
+ * @param[in] data - message for pre-parsing
+ * @param[in] len  - length of pre-parsed data
+ * @param[in] delimiter - FIX SOH
+ * @param[in] tags - requested tags
+ * @param[out] spans - values of requested tags, spans[i] holds value of tags[i]. If tag is repeated, first value is returned.
+ * If tag is not found, its span data is NULL
+ * @param[in] tagCount - count of requested tags
+ * @param[in] maxFields - stop after this count of fields is scanned, 0 - no limit
+ * @param[out] found - count of found tags
+ * @param[out] error - error description, if any. If error is returned it must be destroyed by fix_error_free(error)
+ * @return FIX_SUCCESS - ok, scanning stops as soon as all tags are found, FIX_FAILED - bad data
+ */
+FIX_PARSER_API FIXErrCode fix_parser_peek(char const* data, uint32_t len, char delimiter, FIXTagNum const* tags,
+      FIXFieldSpan* spans, uint32_t tagCount, uint32_t maxFields, uint32_t* found, FIXError** error);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,89 @@
+/**
+ * @file   fix_template.h
+ * @date   Created on: 10/17/2026 04:20:12 PM
+ */
+
+#ifndef FIX_PARSER_FIX_TEMPLATE_H
+#define FIX_PARSER_FIX_TEMPLATE_H
+
+#include "fix_types.h"
+#include "fix_parser_dll.h"
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * create message template. Message is serialized once, then values of slot fields are patched in place, BodyLength
+ * and CheckSum are updated incrementally, so sending of the same message shape doesn't walk dictionary at all
+ * @param[in] msg - message, which is serialized into template. It isn't referenced by template and may be freed
+ * @param[in] delimiter - FIX SOH
+ * @param[in] slots - fields, which will be patched. Field must be set in msg, its value length must be equal to width
+ * of fixed-width slot. BeginString, BodyLength, CheckSum, Length and Data fields, group fields and fields
+ * repeated in message can't be patched
+ * @param[in] slotCount - count of slots
+ * @param[out] error - error description, if any. If error is returned it must be destroyed by fix_error_free(error)
+ * @return new template, NULL - see error. Template is independent of parser and must be destroyed by fix_template_free
+ */
+FIX_PARSER_API FIXTemplate* fix_template_create(FIXMsg* msg, char delimiter, FIXTemplateSlot const* slots,
+      uint32_t slotCount, FIXError** error);
+
+/**
+ * free template
+ * @param[in] tmpl - template
+ */
+FIX_PARSER_API void fix_template_free(FIXTemplate* tmpl);
+
+/**
+ * patch slot with string value
+ * @param[in] tmpl - template
+ * @param[in] slot - index of slot in slots passed to fix_template_create
+ * @param[in] val - new value
+ * @param[in] len - length of value. Must be equal to width of fixed-width slot. Empty value or value with delimiter
+ * is rejected
+ * @param[out] error - error description, if any. If error is returned it must be destroyed by fix_error_free(error)
+ * @return FIX_SUCCESS - ok, FIX_FAILED - see error
+ */
+FIX_PARSER_API FIXErrCode fix_template_set_string(FIXTemplate* tmpl, uint32_t slot, char const* val, uint32_t len,
+      FIXError** error);
+
+/**
+ * patch slot with integer value. Value of fixed-width slot is padded by leading zeros
+ * @param[in] tmpl - template
+ * @param[in] slot - index of slot in slots passed to fix_template_create
+ * @param[in] val - new value
+ * @param[out] error - error description, if any. If error is returned it must be destroyed by fix_error_free(error)
+ * @return FIX_SUCCESS - ok, FIX_FAILED - see error
+ */
+FIX_PARSER_API FIXErrCode fix_template_set_int64(FIXTemplate* tmpl, uint32_t slot, int64_t val, FIXError** error);
+
+/**
+ * patch slot with scaled decimal value mantissa * 10^exponent, see fix_msg_set_decimal. Value of fixed-width slot is
+ * padded by leading zeros
+ * @param[in] tmpl - template
+ * @param[in] slot - index of slot in slots passed to fix_template_create
+ * @param[in] mantissa - decimal mantissa
+ * @param[in] exponent - decimal exponent, in range [-18, 18]
+ * @param[out] error - error description, if any. If error is returned it must be destroyed by fix_error_free(error)
+ * @return FIX_SUCCESS - ok, FIX_FAILED - see error
+ */
+FIX_PARSER_API FIXErrCode fix_template_set_decimal(FIXTemplate* tmpl, uint32_t slot, int64_t mantissa, int32_t exponent,
+      FIXError** error);
+
+/**
+ * return serialized message with patched values, BodyLength and CheckSum. Data is valid till next call to template
+ * @param[in] tmpl - template
+ * @param[out] data - serialized message
+ * @param[out] len - length of serialized message
+ * @return FIX_SUCCESS - ok, FIX_FAILED - bad arguments
+ */
+FIX_PARSER_API FIXErrCode fix_template_get_data(FIXTemplate* tmpl, char const** data, uint32_t* len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FIX_PARSER_FIX_TEMPLATE_H */
@@ -10,6 +10,7 @@
 #include "fix_field_tag.h"
 
 #include  <stdint.h>
+#include  <stddef.h>
 
 #ifdef __cplusplus
 extern "C"
@@ -46,15 +47,37 @@ extern "C"
 #define FIX_ERROR_INTEGRITY_CHECK           -23
 #define FIX_ERROR_NO_MORE_DATA              -24
 #define FIX_ERROR_WRONG_FIELD_VALUE         -25
+#define FIX_ERROR_NO_MORE_MSGS              -26
 
 typedef struct FIXGroup_ FIXGroup;
 typedef struct FIXField_ FIXField;
 typedef struct FIXMsg_ FIXMsg;
 typedef struct FIXParser_ FIXParser;
 typedef struct FIXError_ FIXError;
+typedef struct FIXFramer_ FIXFramer;
+typedef struct FIXTemplate_ FIXTemplate;
+typedef struct FIXProtocolDescr_ FIXProtocolDescr;
 typedef int32_t FIXTagNum;  ///< FIX field tag type
 typedef int32_t FIXErrCode; ///< error code
 
+/**
+ * reference to FIX field value inside of parsed data
+ */
+typedef struct FIXFieldSpan_
+{
+   char const* data; ///< begin of field value, NULL - field not found
+   uint32_t len;     ///< length of field value
+} FIXFieldSpan;
+
+/**
+ * patch slot of message template, see fix_template_create
+ */
+typedef struct FIXTemplateSlot_
+{
+   FIXTagNum tag;    ///< tag of message field (not a group one)
+   uint32_t width;   ///< fixed width of value, 0 - value length may change with every patch
+} FIXTemplateSlot;
+
 #define PARSER_FLAG_CHECK_CRC 0x01       ///< check FIX message CRC during parsing
 #define PARSER_FLAG_CHECK_REQUIRED 0x02  ///< check for required FIX fields
 #define PARSER_FLAG_CHECK_VALUE    0x04  ///< check for valid value.
@@ -62,6 +85,14 @@ typedef int32_t FIXErrCode; ///< error code
 #define PARSER_FLAG_CHECK_ALL \
    (PARSER_FLAG_CHECK_CRC | PARSER_FLAG_CHECK_REQUIRED | PARSER_FLAG_CHECK_VALUE | PARSER_FLAG_CHECK_UNKNOWN_FIELDS) ///< make all possible checks during parsing.
 
+#define POOL_FLAG_SLAB        0x01 ///< pages, groups and messages allocated at parser creation are carved from one contiguous region
+#define POOL_FLAG_HUGE_PAGES  0x02 ///< back slab with huge pages (MAP_HUGETLB, or transparent huge pages if none reserved). Implies POOL_FLAG_SLAB
+#define POOL_FLAG_LOCK        0x04 ///< lock slab in RAM (mlock). Implies POOL_FLAG_SLAB
+#define POOL_FLAG_PREFAULT    0x08 ///< touch every slab page at parser creation, so no page faults on hot path. Implies POOL_FLAG_SLAB
+#define POOL_FLAG_NUMA        0x10 ///< bind slab to NUMA node FIXParserAttrs::numaNode (mbind), whatever thread touches it first. Implies POOL_FLAG_SLAB
+#define POOL_FLAG_ALL \
+   (POOL_FLAG_SLAB | POOL_FLAG_HUGE_PAGES | POOL_FLAG_LOCK | POOL_FLAG_PREFAULT | POOL_FLAG_NUMA)
+
 /**
  * Determine FIX field category (simple value or group of fields)
  */
@@ -122,6 +153,16 @@ FIXFieldValueTypeEnum str2FIXFieldValueType(char const* type);
 #define IS_CHAR_TYPE(type)   ((type & 0xF00) > 0)
 #define IS_DATA_TYPE(type)   ((type & 0xF0000) > 0)
 
+/**
+ * user memory allocator. Memory returned by alloc may be not zeroed
+ */
+typedef struct FIXAllocator_
+{
+   void* (*alloc)(void* ctx, size_t size);   ///< allocate size bytes, return NULL on failure
+   void (*free)(void* ctx, void* ptr);       ///< release memory returned by alloc
+   void* ctx;                                ///< user context, passed to alloc and free
+} FIXAllocator;
+
 /**
  * FIX parser attributes. Determine memory usage stategy
  */
@@ -133,8 +174,48 @@ typedef struct FIXParserAttrs
    uint32_t maxPages;     ///< Maximum alocated pages. 0 - not bounded, numPages - only numPages pages can be allocates. Default 0
    uint32_t numGroups;    ///< Groups allocated at parser creation. Default 1000
    uint32_t maxGroups;    ///< Maximum allocated groups. 0 - not bounded, numGroups - onlu numGroups groups can be allocated. Default 0
+   uint32_t numMsgs;      ///< Messages allocated at parser creation. Default 1000
+   uint32_t maxMsgs;      ///< Maximum allocated messages. 0 - not bounded, numMsgs - only numMsgs messages can be allocated. Default 0
+   uint32_t poolFlags;    ///< How pools are allocated at parser creation. See POOL_FLAG_* values. 0 - each object by calloc. Default 0
+   uint32_t arenaSize;    ///< Size of arena block, small message pages are carved from. 0 - no arena, each message takes whole pages. Default 0
+   FIXAllocator allocator; ///< Memory allocator of pools, arena blocks and protocol description loaded by parser. NULL alloc and free - calloc/free. Slab is always taken from OS
+   uint32_t numaNode;     ///< NUMA node of slab, if POOL_FLAG_NUMA is set. Objects allocated when pools are exhausted are not bound, use allocator for them. Default 0
 } FIXParserAttrs;
 
+/**
+ * memory usage statistics of one message type
+ */
+typedef struct FIXMsgStats_
+{
+   uint32_t count;        ///< count of measured messages. Message is measured, when it is reset or freed
+   uint32_t avgSize;      ///< moving average of page space used by message, bytes
+   uint32_t maxSize;      ///< maximum page space used by message, bytes
+} FIXMsgStats;
+
+/**
+ * usage statistics of one parser pool
+ */
+typedef struct FIXPoolStats_
+{
+   uint32_t used;         ///< objects in use
+   uint32_t peak;         ///< maximum count of objects in use at the same time
+   uint32_t free;         ///< allocated objects ready for reuse
+   uint32_t overflows;    ///< objects allocated from heap, because pool was empty
+   uint32_t failures;     ///< refused allocations, because of max* attribute or too big page
+} FIXPoolStats;
+
+/**
+ * usage statistics of parser memory
+ */
+typedef struct FIXParserStats_
+{
+   FIXPoolStats pages;          ///< pages, including ones carved from arena
+   FIXPoolStats groups;         ///< groups
+   FIXPoolStats msgs;           ///< message headers
+   uint32_t arenaBlocks;        ///< arena blocks allocated
+   uint32_t freeArenaBlocks;    ///< arena blocks without live pages
+} FIXParserStats;
+
 #ifdef __cplusplus
 }
 #endif
@@ -3,9 +3,19 @@
    @date   Created on: 08/27/2012 05:35:55 PM
 */
 
+#ifdef __linux__
+#  define _GNU_SOURCE // sched_setaffinity
+#endif
+
 #include "fix_parser.h"
 #include "fix_msg.h"
 #include "fix_error.h"
+#include "fix_utils.h"
+#include "fix_framer.h"
+#include "fix_template.h"
+#include "fix_protocol_descr.h"
+#include "fix_msg_priv.h"
+#include "fix_page.h"
 
 #include <stdlib.h>
 #include <stdio.h>
@@ -13,6 +23,14 @@
 #  include <windows.h>
 #else
 #  include <time.h>
+#  include <pthread.h>
+#endif
+#ifdef __linux__
+#  include <linux/perf_event.h>
+#  include <sys/ioctl.h>
+#  include <sys/syscall.h>
+#  include <unistd.h>
+#  include <sched.h>
 #endif
 #include <string.h>
 #include <assert.h>
@@ -86,6 +104,44 @@ void create_msg(FIXParser* parser)
    printf("%12s%12d%12d%10.2f\n", "create_msg", count, total, (float)total/count);
 }
 
+void update_msg(FIXParser* parser)
+{
+   TIMESTAMP_INIT;
+   TIMESTAMP start, stop;
+
+   FIXError* error = NULL;
+   FIXMsg* msg = fix_msg_create(parser, "8", &error);
+   assert(msg != NULL);
+
+   static char const text[] = "COMMENT_COMMENT_COMMENT_COMMENT_COMMENT_COMMENT_COMMENT_";
+
+   GET_TIMESTAMP(start);
+
+   int32_t const count = 1000000;
+
+   for(int32_t i = 0; i < count; ++i)
+   {
+      // outbound template: fields are rewritten with values of varying length
+      assert(FIX_SUCCESS == fix_msg_set_int32(msg, NULL, FIXFieldTag_MsgSeqNum, i, &error));
+      assert(FIX_SUCCESS == fix_msg_set_string(msg, NULL, FIXFieldTag_SendingTime,
+               i % 2 ? "20120716-06:00:16" : "20120716-06:00:16.230", &error));
+      assert(FIX_SUCCESS == fix_msg_set_string_len(msg, NULL, FIXFieldTag_Text, text, 8 + i % 48, &error));
+      assert(FIX_SUCCESS == fix_msg_set_double(msg, NULL, FIXFieldTag_Price, 135155.0 + i % 1000, &error));
+   }
+
+   GET_TIMESTAMP(stop);
+
+   uint32_t pages = 0;
+   for(FIXPage const* page = msg->pages; page; page = page->next)
+   {
+      ++pages;
+   }
+   fix_msg_free(msg);
+
+   int32_t const total = GET_TIMESTAMP_DIFF_USEC(stop, start);
+   printf("%12s%12d%12d%10.2f  pages: %u\n", "update_msg", count, total, (float)total/count, pages);
+}
+
 void msg_to_str(FIXParser* parser)
 {
    TIMESTAMP_INIT;
@@ -172,27 +228,1059 @@ void str_to_msg(FIXParser* parser)
    printf("%12s%12d%12d%10.2f\n", "str_to_msg", count, total, (float)total/count);
 }
 
-int main(int argc, char *argv[])
+void str_to_msg_into(FIXParser* parser)
 {
-   if (argc == 1)
+   TIMESTAMP_INIT;
+   TIMESTAMP start, stop;
+
+   char buff[] = "8=FIX.4.4|9=228|35=8|49=QWERTY_12345678|56=ABCQWE_XYZ|34=34|57=srv-ivanov_ii1|52=20120716-06:00:16.230|37=1|11=CL_ORD_ID_1234567|17=FE_1_9494_1|150=0|39=1|1=ZUM|55=RTS-12.12|54=1|38=25|44=135155|59=0|32=0|31=0|151=25|14=0|6=0|21=1|58=COMMENT12|10=110|";
+   size_t len = strlen(buff);
+
+   FIXError* error = NULL;
+   FIXMsg* msg = fix_msg_create(parser, "8", &error);
+   assert(msg != NULL);
+
+   GET_TIMESTAMP(start);
+
+   int32_t const count = 1000000;
+
+   for(int32_t i = 0; i < count; ++i)
    {
-      printf("perf_test <prot_file.xml>\n");
-      return 1;
+      char const* stop = NULL;
+      FIXErrCode res = fix_parser_str_to_msg_into(parser, msg, buff, len, '|', &stop, &error);
+      assert(res == FIX_SUCCESS);
+      (void)res;
    }
 
+   GET_TIMESTAMP(stop);
+
+   fix_msg_free(msg);
+
+   int32_t const total = GET_TIMESTAMP_DIFF_USEC(stop, start);
+   printf("%12s%12d%12d%10.2f\n", "str_to_into", count, total, (float)total/count);
+}
+
+#ifndef WIN32
+#define MT_MAX_THREADS 16
+
+static void* str_to_msg_worker(void* arg)
+{
    FIXError* error = NULL;
-   FIXParser* parser = fix_parser_create(argv[1], NULL, PARSER_FLAG_CHECK_ALL, &error);
+   FIXParser* parser = fix_parser_create_with_protocol((FIXProtocolDescr const*)arg, NULL, PARSER_FLAG_CHECK_ALL, &error);
+   assert(parser != NULL);
+
+   char buff[] = "8=FIX.4.4|9=228|35=8|49=QWERTY_12345678|56=ABCQWE_XYZ|34=34|57=srv-ivanov_ii1|52=20120716-06:00:16.230|37=1|11=CL_ORD_ID_1234567|17=FE_1_9494_1|150=0|39=1|1=ZUM|55=RTS-12.12|54=1|38=25|44=135155|59=0|32=0|31=0|151=25|14=0|6=0|21=1|58=COMMENT12|10=110|";
+   size_t len = strlen(buff);
+
+   FIXMsg* msg = fix_msg_create(parser, "8", &error);
+   assert(msg != NULL);
+
+   int32_t const count = 1000000;
+
+   for(int32_t i = 0; i < count; ++i)
+   {
+      char const* stop = NULL;
+      FIXErrCode res = fix_parser_str_to_msg_into(parser, msg, buff, len, '|', &stop, &error);
+      assert(res == FIX_SUCCESS);
+      (void)res;
+   }
+
+   fix_msg_free(msg);
+   fix_parser_free(parser);
+   return NULL;
+}
+
+void str_to_msg_mt(FIXParser* parser, uint32_t threadCount)
+{
+   TIMESTAMP_INIT;
+   TIMESTAMP start, stop;
+
+   pthread_t threads[MT_MAX_THREADS];
+   assert(threadCount <= MT_MAX_THREADS);
+
+   GET_TIMESTAMP(start);
+
+   for(uint32_t i = 0; i < threadCount; ++i)
+   {
+      pthread_create(&threads[i], NULL, &str_to_msg_worker, (void*)fix_parser_get_protocol(parser));
+   }
+   for(uint32_t i = 0; i < threadCount; ++i)
+   {
+      pthread_join(threads[i], NULL);
+   }
+
+   GET_TIMESTAMP(stop);
+
+   int32_t const count = 1000000 * threadCount;
+   int32_t const total = GET_TIMESTAMP_DIFF_USEC(stop, start);
+   char name[16];
+   sprintf(name, "threads=%u", threadCount);
+   printf("%12s%12d%12d%10.3f\n", name, count, total, (float)total/count);
+}
+#endif
+
+/* open counter of data TLB misses of this thread. Return -1, if counter is not available */
+static int tlb_counter_open(void)
+{
+#ifdef __linux__
+   struct perf_event_attr attr;
+   memset(&attr, 0, sizeof(attr));
+   attr.type = PERF_TYPE_HW_CACHE;
+   attr.size = sizeof(attr);
+   attr.config = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+   attr.disabled = 1;
+   attr.exclude_kernel = 1;
+   attr.exclude_hv = 1;
+   return syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+#else
+   return -1;
+#endif
+}
+
+static long long tlb_counter_read(int fd)
+{
+   long long val = -1;
+#ifdef __linux__
+   if (fd >= 0 && read(fd, &val, sizeof(val)) != sizeof(val))
+   {
+      val = -1;
+   }
+#endif
+   return val;
+}
+
+void pool_walk(char const* protFile, uint32_t poolFlags, uint32_t numaNode, char const* name)
+{
+   TIMESTAMP_INIT;
+   TIMESTAMP start, stop;
+
+   FIXError* error = NULL;
+   FIXParserAttrs attrs = {4096, 0, 4096, 0, 1000, 0, 1024, 0, poolFlags};
+   attrs.numaNode = numaNode;
+   FIXParser* parser = fix_parser_create(protFile, &attrs, PARSER_FLAG_CHECK_ALL, &error);
    if (!parser)
    {
-      printf("ERROR: %s\n", fix_error_get_text(error));
-      free(error);
-      return 1;
+      printf("%12s ERROR: %s\n", name, fix_error_get_text(error));
+      fix_error_free(error);
+      return;
    }
 
-   printf("%12s%12s%12s%12s", "test", "count", "total", "per msg\n");
-   create_msg(parser);
-   msg_to_str(parser);
-   str_to_msg(parser);
+   char buff[] = "8=FIX.4.4|9=228|35=8|49=QWERTY_12345678|56=ABCQWE_XYZ|34=34|57=srv-ivanov_ii1|52=20120716-06:00:16.230|37=1|11=CL_ORD_ID_1234567|17=FE_1_9494_1|150=0|39=1|1=ZUM|55=RTS-12.12|54=1|38=25|44=135155|59=0|32=0|31=0|151=25|14=0|6=0|21=1|58=COMMENT12|10=110|";
+   size_t len = strlen(buff);
+
+   // window of live messages spans thousands of pool pages, so each parse lands on a cold TLB entry
+   enum { WINDOW = 1024 };
+   FIXMsg* msgs[WINDOW];
+   for(int32_t i = 0; i < WINDOW; ++i)
+   {
+      msgs[i] = fix_msg_create(parser, "8", &error);
+      assert(msgs[i] != NULL);
+   }
+
+   int const fd = tlb_counter_open();
+#ifdef __linux__
+   if (fd >= 0)
+   {
+      ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+      ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+   }
+#endif
+
+   GET_TIMESTAMP(start);
+
+   int32_t const count = 1000000;
+
+   for(int32_t i = 0; i < count; ++i)
+   {
+      char const* stop = NULL;
+      FIXErrCode res = fix_parser_str_to_msg_into(parser, msgs[(i * 7) % WINDOW], buff, len, '|', &stop, &error);
+      assert(res == FIX_SUCCESS);
+      (void)res;
+   }
+
+   GET_TIMESTAMP(stop);
+
+   long long const misses = tlb_counter_read(fd);
+#ifdef __linux__
+   if (fd >= 0)
+   {
+      close(fd);
+   }
+#endif
+
+   for(int32_t i = 0; i < WINDOW; ++i)
+   {
+      fix_msg_free(msgs[i]);
+   }
+   fix_parser_free(parser);
+
+   int32_t const total = GET_TIMESTAMP_DIFF_USEC(stop, start);
+   printf("%12s%12d%12d%10.2f%14lld\n", name, count, total, (float)total/count, misses);
+}
+
+#ifdef __linux__
+/* parse on this thread into pools bound to every NUMA node in turn, so local and remote latency can be compared */
+void numa_walk(char const* protFile)
+{
+   unsigned cpu = 0, localNode = 0;
+   if (syscall(SYS_getcpu, &cpu, &localNode, NULL))
+   {
+      printf("%12s ERROR: getcpu failed\n", "numa");
+      return;
+   }
+   cpu_set_t oldSet, set;
+   sched_getaffinity(0, sizeof(oldSet), &oldSet);
+   CPU_ZERO(&set);
+   CPU_SET(cpu, &set);
+   sched_setaffinity(0, sizeof(set), &set);
+   for(uint32_t node = 0; node < 64; ++node)
+   {
+      char path[64];
+      snprintf(path, sizeof(path), "/sys/devices/system/node/node%u", node);
+      if (access(path, F_OK))
+      {
+         continue;
+      }
+      char name[16];
+      snprintf(name, sizeof(name), "%u/%s", node, node == localNode ? "local" : "remote");
+      pool_walk(protFile, POOL_FLAG_NUMA | POOL_FLAG_PREFAULT, node, name);
+   }
+   sched_setaffinity(0, sizeof(oldSet), &oldSet);
+}
+#endif
+
+void md_refresh(FIXParser* parser, uint32_t entries)
+{
+   TIMESTAMP_INIT;
+   TIMESTAMP start, stop;
+
+   FIXError* error = NULL;
+   FIXMsg* msg = fix_msg_create(parser, "X", &error);
+   assert(msg != NULL);
+   assert(FIX_SUCCESS == fix_msg_set_string(msg, NULL, FIXFieldTag_SenderCompID, "QWERTY_12345678", &error));
+   assert(FIX_SUCCESS == fix_msg_set_string(msg, NULL, FIXFieldTag_TargetCompID, "ABCQWE_XYZ", &error));
+   assert(FIX_SUCCESS == fix_msg_set_int32(msg, NULL, FIXFieldTag_MsgSeqNum, 34, &error));
+   assert(FIX_SUCCESS == fix_msg_set_string(msg, NULL, FIXFieldTag_SendingTime, "20120716-06:00:16.230", &error));
+   for(uint32_t i = 0; i < entries; ++i)
+   {
+      FIXGroup* grp = fix_msg_add_group(msg, NULL, FIXFieldTag_NoMDEntries, &error);
+      assert(grp != NULL);
+      assert(FIX_SUCCESS == fix_msg_set_char(msg, grp, FIXFieldTag_MDUpdateAction, '0', &error));
+      assert(FIX_SUCCESS == fix_msg_set_char(msg, grp, FIXFieldTag_MDEntryType, i % 2 ? '1' : '0', &error));
+      char id[16];
+      sprintf(id, "MD_%u", 1000 + i);
+      assert(FIX_SUCCESS == fix_msg_set_string(msg, grp, FIXFieldTag_MDEntryID, id, &error));
+      assert(FIX_SUCCESS == fix_msg_set_string(msg, grp, FIXFieldTag_Symbol, "RTS-12.12", &error));
+      assert(FIX_SUCCESS == fix_msg_set_double(msg, grp, FIXFieldTag_MDEntryPx, 135155.0 + i * 5, &error));
+      assert(FIX_SUCCESS == fix_msg_set_double(msg, grp, FIXFieldTag_MDEntrySize, 25 + i, &error));
+   }
+   char buff[4096];
+   uint32_t len = 0;
+   assert(FIX_SUCCESS == fix_msg_to_str(msg, '|', buff, sizeof(buff), &len, &error));
+
+   GET_TIMESTAMP(start);
+
+   int32_t const count = 200000;
+
+   for(int32_t i = 0; i < count; ++i)
+   {
+      char const* stop = NULL;
+      FIXErrCode res = fix_parser_str_to_msg_into(parser, msg, buff, len, '|', &stop, &error);
+      assert(res == FIX_SUCCESS);
+      (void)res;
+   }
+
+   GET_TIMESTAMP(stop);
+
+   fix_msg_free(msg);
+
+   int32_t const total = GET_TIMESTAMP_DIFF_USEC(stop, start);
+   char name[16];
+   sprintf(name, "md_into/%u", entries);
+   printf("%12s%12d%12d%10.2f\n", name, count, total, (float)total/count);
+}
+
+/* resident memory of process in KB, -1 - unknown */
+static long resident_kb(void)
+{
+   long kb = -1;
+#ifdef __linux__
+   FILE* f = fopen("/proc/self/statm", "r");
+   if (f)
+   {
+      long size = 0, resident = 0;
+      if (fscanf(f, "%ld %ld", &size, &resident) == 2)
+      {
+         kb = resident * (sysconf(_SC_PAGESIZE) / 1024);
+      }
+      fclose(f);
+   }
+#endif
+   return kb;
+}
+
+void serialize(FIXParser* parser, uint32_t entries)
+{
+   TIMESTAMP_INIT;
+   TIMESTAMP start, stop;
+
+   // the same market data refresh as md_refresh, only serialization is measured
+   FIXError* error = NULL;
+   FIXMsg* msg = fix_msg_create(parser, "X", &error);
+   assert(msg != NULL);
+   assert(FIX_SUCCESS == fix_msg_set_string(msg, NULL, FIXFieldTag_SenderCompID, "QWERTY_12345678", &error));
+   assert(FIX_SUCCESS == fix_msg_set_string(msg, NULL, FIXFieldTag_TargetCompID, "ABCQWE_XYZ", &error));
+   assert(FIX_SUCCESS == fix_msg_set_int32(msg, NULL, FIXFieldTag_MsgSeqNum, 34, &error));
+   assert(FIX_SUCCESS == fix_msg_set_string(msg, NULL, FIXFieldTag_SendingTime, "20120716-06:00:16.230", &error));
+   for(uint32_t i = 0; i < entries; ++i)
+   {
+      FIXGroup* grp = fix_msg_add_group(msg, NULL, FIXFieldTag_NoMDEntries, &error);
+      assert(grp != NULL);
+      assert(FIX_SUCCESS == fix_msg_set_char(msg, grp, FIXFieldTag_MDUpdateAction, '0', &error));
+      assert(FIX_SUCCESS == fix_msg_set_char(msg, grp, FIXFieldTag_MDEntryType, i % 2 ? '1' : '0', &error));
+      char id[16];
+      sprintf(id, "MD_%u", 1000 + i);
+      assert(FIX_SUCCESS == fix_msg_set_string(msg, grp, FIXFieldTag_MDEntryID, id, &error));
+      assert(FIX_SUCCESS == fix_msg_set_string(msg, grp, FIXFieldTag_Symbol, "RTS-12.12", &error));
+      assert(FIX_SUCCESS == fix_msg_set_double(msg, grp, FIXFieldTag_MDEntryPx, 135155.0 + i * 5, &error));
+      assert(FIX_SUCCESS == fix_msg_set_double(msg, grp, FIXFieldTag_MDEntrySize, 25 + i, &error));
+   }
+   char buff[4096];
+   uint32_t len = 0;
+   int32_t const count = 200000;
+
+   GET_TIMESTAMP(start);
+
+   for(int32_t i = 0; i < count; ++i)
+   {
+      FIXErrCode res = fix_msg_to_str(msg, '|', buff, sizeof(buff), &len, &error);
+      assert(res == FIX_SUCCESS);
+      (void)res;
+   }
+
+   GET_TIMESTAMP(stop);
+
+   fix_msg_free(msg);
+
+   int32_t const total = GET_TIMESTAMP_DIFF_USEC(stop, start);
+   char name[16];
+   sprintf(name, "to_str/%u", entries);
+   printf("%12s%12d%12d%10.2f\n", name, count, total, (float)total/count);
+}
+
+void send_msg(FIXParser* parser, uint32_t useTemplate)
+{
+   TIMESTAMP_INIT;
+   TIMESTAMP start, stop;
+
+   // outbound hot path: the same message shape, only sequence number, time, id, price and quantity differ
+   FIXError* error = NULL;
+   FIXMsg* msg = fix_msg_create(parser, "8", &error);
+   assert(msg != NULL);
+   assert(FIX_SUCCESS == fix_msg_set_string(msg, NULL, FIXFieldTag_SenderCompID, "QWERTY_12345678", &error));
+   assert(FIX_SUCCESS == fix_msg_set_string(msg, NULL, FIXFieldTag_TargetCompID, "ABCQWE_XYZ", &error));
+   assert(FIX_SUCCESS == fix_msg_set_int32(msg, NULL, FIXFieldTag_MsgSeqNum, 1, &error));
+   assert(FIX_SUCCESS == fix_msg_set_string(msg, NULL, FIXFieldTag_SendingTime, "20120716-06:00:16.230", &error));
+   assert(FIX_SUCCESS == fix_msg_set_string(msg, NULL, FIXFieldTag_OrderID, "1", &error));
+   assert(FIX_SUCCESS == fix_msg_set_string(msg, NULL, FIXFieldTag_ClOrdID, "CL_ORD_ID_1", &error));
+   assert(FIX_SUCCESS == fix_msg_set_string(msg, NULL, FIXFieldTag_ExecID, "FE_1_9494_1", &error));
+   assert(FIX_SUCCESS == fix_msg_set_char(msg, NULL, FIXFieldTag_ExecType, '0', &error));
+   assert(FIX_SUCCESS == fix_msg_set_char(msg, NULL, FIXFieldTag_OrdStatus, '0', &error));
+   assert(FIX_SUCCESS == fix_msg_set_string(msg, NULL, FIXFieldTag_Symbol, "RTS-12.12", &error));
+   assert(FIX_SUCCESS == fix_msg_set_char(msg, NULL, FIXFieldTag_Side, '1', &error));
+   assert(FIX_SUCCESS == fix_msg_set_decimal(msg, NULL, FIXFieldTag_OrderQty, 25, 0, &error));
+   assert(FIX_SUCCESS == fix_msg_set_decimal(msg, NULL, FIXFieldTag_Price, 13515, -2, &error));
+   assert(FIX_SUCCESS == fix_msg_set_double(msg, NULL, FIXFieldTag_LeavesQty, 25.0, &error));
+   assert(FIX_SUCCESS == fix_msg_set_double(msg, NULL, FIXFieldTag_CumQty, 0, &error));
+   assert(FIX_SUCCESS == fix_msg_set_double(msg, NULL, FIXFieldTag_AvgPx, 0.0, &error));
+   FIXTemplateSlot const slots[] =
+   {
+      {FIXFieldTag_MsgSeqNum, 0}, {FIXFieldTag_SendingTime, 21}, {FIXFieldTag_ClOrdID, 0},
+      {FIXFieldTag_Price, 0}, {FIXFieldTag_OrderQty, 0}
+   };
+   FIXTemplate* tmpl = fix_template_create(msg, '|', slots, sizeof(slots) / sizeof(slots[0]), &error);
+   assert(tmpl != NULL);
+
+   char buff[1024];
+   int32_t const count = 1000000;
+   int64_t written = 0;
+
+   GET_TIMESTAMP(start);
+
+   for(int32_t i = 0; i < count; ++i)
+   {
+      char id[16];
+      int32_t const idLen = fix_utils_i64toa(1000 + i, id, sizeof(id), 0);
+      if (useTemplate)
+      {
+         char const* data = NULL;
+         uint32_t len = 0;
+         fix_template_set_int64(tmpl, 0, i + 1, &error);
+         fix_template_set_string(tmpl, 1, "20120716-06:00:16.230", 21, &error);
+         fix_template_set_string(tmpl, 2, id, idLen, &error);
+         fix_template_set_decimal(tmpl, 3, 13500 + i % 100, -2, &error);
+         fix_template_set_decimal(tmpl, 4, 1 + i % 50, 0, &error);
+         fix_template_get_data(tmpl, &data, &len);
+         memcpy(buff, data, len);
+         written += len;
+      }
+      else
+      {
+         uint32_t len = 0;
+         fix_msg_set_int32(msg, NULL, FIXFieldTag_MsgSeqNum, i + 1, &error);
+         fix_msg_set_string(msg, NULL, FIXFieldTag_SendingTime, "20120716-06:00:16.230", &error);
+         fix_msg_set_string_len(msg, NULL, FIXFieldTag_ClOrdID, id, idLen, &error);
+         fix_msg_set_decimal(msg, NULL, FIXFieldTag_Price, 13500 + i % 100, -2, &error);
+         fix_msg_set_decimal(msg, NULL, FIXFieldTag_OrderQty, 1 + i % 50, 0, &error);
+         fix_msg_to_str(msg, '|', buff, sizeof(buff), &len, &error);
+         written += len;
+      }
+   }
+
+   GET_TIMESTAMP(stop);
+
+   fix_template_free(tmpl);
+   fix_msg_free(msg);
+
+   int32_t const total = GET_TIMESTAMP_DIFF_USEC(stop, start);
+   printf("%12s%12d%12d%10.2f\n", useTemplate ? "send/tmpl" : "send/msg", count, total, (float)total/count);
+   assert(written > count);
+}
+
+void live_msgs(char const* protFile, uint32_t arenaSize, char const* name)
+{
+   TIMESTAMP_INIT;
+   TIMESTAMP start, stop;
+
+   FIXError* error = NULL;
+   FIXParserAttrs attrs = {4096, 0, 1, 0, 1, 0, 1, 0, 0, arenaSize};
+   FIXParser* parser = fix_parser_create(protFile, &attrs, PARSER_FLAG_CHECK_ALL, &error);
+   if (!parser)
+   {
+      printf("%12s ERROR: %s\n", name, fix_error_get_text(error));
+      fix_error_free(error);
+      return;
+   }
+
+   char buff[] = "8=FIX.4.4|9=228|35=8|49=QWERTY_12345678|56=ABCQWE_XYZ|34=34|57=srv-ivanov_ii1|52=20120716-06:00:16.230|37=1|11=CL_ORD_ID_1234567|17=FE_1_9494_1|150=0|39=1|1=ZUM|55=RTS-12.12|54=1|38=25|44=135155|59=0|32=0|31=0|151=25|14=0|6=0|21=1|58=COMMENT12|10=110|";
+   size_t len = strlen(buff);
+
+   // warm up statistics of message type
+   for(int32_t i = 0; i < 100; ++i)
+   {
+      char const* stop = NULL;
+      fix_msg_free(fix_parser_str_to_msg(parser, buff, len, '|', &stop, &error));
+   }
+
+   int32_t const count = 20000;
+   FIXMsg** msgs = (FIXMsg**)malloc(sizeof(FIXMsg*) * count);
+   long const rss = resident_kb();
+
+   GET_TIMESTAMP(start);
+
+   for(int32_t i = 0; i < count; ++i)
+   {
+      char const* stop = NULL;
+      msgs[i] = fix_parser_str_to_msg(parser, buff, len, '|', &stop, &error);
+      assert(msgs[i] != NULL);
+   }
+
+   GET_TIMESTAMP(stop);
+
+   long const held = resident_kb() - rss;
+   for(int32_t i = 0; i < count; ++i)
+   {
+      fix_msg_free(msgs[i]);
+   }
+   free(msgs);
+   fix_parser_free(parser);
+
+   int32_t const total = GET_TIMESTAMP_DIFF_USEC(stop, start);
+   printf("%12s%12d%12d%10.2f%12ld\n", name, count, total, (float)total/count, rss < 0 ? -1 : held);
+}
+
+void str_to_view(FIXParser* parser)
+{
+   TIMESTAMP_INIT;
+   TIMESTAMP start, stop;
+
+   char buff[] = "8=FIX.4.4|9=228|35=8|49=QWERTY_12345678|56=ABCQWE_XYZ|34=34|57=srv-ivanov_ii1|52=20120716-06:00:16.230|37=1|11=CL_ORD_ID_1234567|17=FE_1_9494_1|150=0|39=1|1=ZUM|55=RTS-12.12|54=1|38=25|44=135155|59=0|32=0|31=0|151=25|14=0|6=0|21=1|58=COMMENT12|10=110|";
+   size_t len = strlen(buff);
+
+   GET_TIMESTAMP(start);
+
+   FIXMsg* msg = NULL;
+
+   int32_t const count = 1000000;
+
+   for(int32_t i = 0; i < count; ++i)
+   {
+      FIXError* error = NULL;
+      char const* stop = NULL;
+      msg = fix_parser_str_to_view(parser, buff, len, '|', &stop, &error);
+      assert(msg != NULL);
+      fix_msg_free(msg);
+   }
+
+   GET_TIMESTAMP(stop);
+
+   int32_t const total = GET_TIMESTAMP_DIFF_USEC(stop, start);
+   printf("%12s%12d%12d%10.2f\n", "str_to_view", count, total, (float)total/count);
+}
+
+void str_to_proj(FIXParser* parser)
+{
+   TIMESTAMP_INIT;
+   TIMESTAMP start, stop;
+
+   char buff[] = "8=FIX.4.4|9=228|35=8|49=QWERTY_12345678|56=ABCQWE_XYZ|34=34|57=srv-ivanov_ii1|52=20120716-06:00:16.230|37=1|11=CL_ORD_ID_1234567|17=FE_1_9494_1|150=0|39=1|1=ZUM|55=RTS-12.12|54=1|38=25|44=135155|59=0|32=0|31=0|151=25|14=0|6=0|21=1|58=COMMENT12|10=110|";
+   size_t len = strlen(buff);
+
+   FIXError* error = NULL;
+   FIXTagNum const tags[] = {11, 55, 54, 38, 44};
+   if (fix_parser_set_projection(parser, "8", tags, sizeof(tags) / sizeof(tags[0]), &error) == FIX_FAILED)
+   {
+      printf("ERROR: %s\n", fix_error_get_text(error));
+      fix_error_free(error);
+      return;
+   }
+
+   GET_TIMESTAMP(start);
+
+   FIXMsg* msg = NULL;
+
+   int32_t const count = 1000000;
+
+   for(int32_t i = 0; i < count; ++i)
+   {
+      char const* stop = NULL;
+      msg = fix_parser_str_to_msg(parser, buff, len, '|', &stop, &error);
+      assert(msg != NULL);
+      fix_msg_free(msg);
+   }
+
+   GET_TIMESTAMP(stop);
+
+   fix_parser_reset_projection(parser, "8");
+
+   int32_t const total = GET_TIMESTAMP_DIFF_USEC(stop, start);
+   printf("%12s%12d%12d%10.2f\n", "str_to_proj", count, total, (float)total/count);
+}
+
+void peek(void)
+{
+   TIMESTAMP_INIT;
+   TIMESTAMP start, stop;
+
+   char buff[] = "8=FIX.4.4|9=228|35=8|49=QWERTY_12345678|56=ABCQWE_XYZ|34=34|57=srv-ivanov_ii1|52=20120716-06:00:16.230|37=1|11=CL_ORD_ID_1234567|17=FE_1_9494_1|150=0|39=1|1=ZUM|55=RTS-12.12|54=1|38=25|44=135155|59=0|32=0|31=0|151=25|14=0|6=0|21=1|58=COMMENT12|10=110|";
+   size_t len = strlen(buff);
+   FIXTagNum const tags[] = {35, 49, 56, 1, 55};
+   FIXFieldSpan spans[sizeof(tags) / sizeof(tags[0])];
+
+   GET_TIMESTAMP(start);
+
+   int32_t const count = 1000000;
+
+   for(int32_t i = 0; i < count; ++i)
+   {
+      FIXError* error = NULL;
+      uint32_t found = 0;
+      FIXErrCode res = fix_parser_peek(buff, len, '|', tags, spans, sizeof(tags) / sizeof(tags[0]), 0, &found, &error);
+      assert(res == FIX_SUCCESS && found == sizeof(tags) / sizeof(tags[0]));
+      (void)res;
+   }
+
+   GET_TIMESTAMP(stop);
+
+   int32_t const total = GET_TIMESTAMP_DIFF_USEC(stop, start);
+   printf("%12s%12d%12d%10.2f\n", "peek", count, total, (float)total/count);
+}
+
+void str_to_msgs(FIXParser* parser)
+{
+   TIMESTAMP_INIT;
+   TIMESTAMP start, stop;
+
+   char msg[] = "8=FIX.4.4|9=228|35=8|49=QWERTY_12345678|56=ABCQWE_XYZ|34=34|57=srv-ivanov_ii1|52=20120716-06:00:16.230|37=1|11=CL_ORD_ID_1234567|17=FE_1_9494_1|150=0|39=1|1=ZUM|55=RTS-12.12|54=1|38=25|44=135155|59=0|32=0|31=0|151=25|14=0|6=0|21=1|58=COMMENT12|10=110|";
+   size_t const msgLen = strlen(msg);
+   enum { batch = 32 };
+   char buff[sizeof(msg) * batch];
+   for(int32_t i = 0; i < batch; ++i)
+   {
+      memcpy(buff + i * msgLen, msg, msgLen);
+   }
+   size_t const len = msgLen * batch;
+
+   GET_TIMESTAMP(start);
+
+   FIXMsg* msgs[batch];
+
+   int32_t const count = 1000000 / batch;
+
+   for(int32_t i = 0; i < count; ++i)
+   {
+      FIXError* error = NULL;
+      char const* stop = NULL;
+      uint32_t parsed = 0;
+      FIXErrCode res = fix_parser_str_to_msgs(parser, buff, len, '|', msgs, batch, &parsed, &stop, &error);
+      assert(res == FIX_SUCCESS && parsed == batch);
+      for(uint32_t j = 0; j < parsed; ++j)
+      {
+         fix_msg_free(msgs[j]);
+      }
+   }
+
+   GET_TIMESTAMP(stop);
+
+   int32_t const total = GET_TIMESTAMP_DIFF_USEC(stop, start);
+   printf("%12s%12d%12d%10.2f\n", "str_to_msgs", count * batch, total, (float)total/(count * batch));
+}
+
+void frame_stream(uint32_t chunk)
+{
+   TIMESTAMP_INIT;
+   TIMESTAMP start, stop;
+
+   char msg[] = "8=FIX.4.4|9=228|35=8|49=QWERTY_12345678|56=ABCQWE_XYZ|34=34|57=srv-ivanov_ii1|52=20120716-06:00:16.230|37=1|11=CL_ORD_ID_1234567|17=FE_1_9494_1|150=0|39=1|1=ZUM|55=RTS-12.12|54=1|38=25|44=135155|59=0|32=0|31=0|151=25|14=0|6=0|21=1|58=COMMENT12|10=110|";
+   size_t const msgLen = strlen(msg);
+   enum { batch = 32 };
+   char buff[sizeof(msg) * batch];
+   for(int32_t i = 0; i < batch; ++i)
+   {
+      memcpy(buff + i * msgLen, msg, msgLen);
+   }
+   size_t const len = msgLen * batch;
+   FIXFramer* framer = fix_framer_create('|', 0);
+
+   GET_TIMESTAMP(start);
+
+   int32_t const count = 1000000 / batch;
+   int32_t framed = 0;
+
+   for(int32_t i = 0; i < count; ++i)
+   {
+      char const* begin = buff;
+      for(size_t received = chunk; begin != buff + len; received += chunk) // simulate partial reads
+      {
+         if (received > len)
+         {
+            received = len;
+         }
+         FIXError* error = NULL;
+         uint32_t frameLen = 0;
+         while(fix_framer_next(framer, begin, buff + received - begin, &frameLen, &error) == FIX_SUCCESS)
+         {
+            begin += frameLen;
+            ++framed;
+         }
+      }
+   }
+
+   GET_TIMESTAMP(stop);
+   fix_framer_free(framer);
+
+   int32_t const total = GET_TIMESTAMP_DIFF_USEC(stop, start);
+   char name[32];
+   snprintf(name, sizeof(name), "frame/%u", chunk);
+   printf("%12s%12d%12d%10.3f\n", name, framed, total, (float)total/framed);
+   assert(framed == count * batch);
+}
+
+void field_lookup(FIXParser* parser, char const* msgType)
+{
+   TIMESTAMP_INIT;
+   TIMESTAMP start, stop;
+
+   FIXError* error = NULL;
+   FIXMsgDescr const* msg = fix_protocol_get_msg_descr(parser, msgType, &error);
+   if (!msg)
+   {
+      printf("ERROR: %s\n", fix_error_get_text(error));
+      fix_error_free(error);
+      return;
+   }
+   FIXTagNum tags[1024];
+   uint32_t tagCount = 0;
+   for(uint32_t i = 0; i < msg->field_count && tagCount < sizeof(tags) / sizeof(tags[0]); ++i)
+   {
+      tags[tagCount++] = msg->fields[i].type->tag;
+   }
+
+   int32_t const count = 10000000 / tagCount;
+   int64_t found = 0;
+
+   GET_TIMESTAMP(start);
+
+   for(int32_t i = 0; i < count; ++i)
+   {
+      for(uint32_t j = 0; j < tagCount; ++j)
+      {
+         found += fix_protocol_get_field_descr(msg, tags[j]) != NULL;
+      }
+   }
+
+   GET_TIMESTAMP(stop);
+
+   int32_t const total = GET_TIMESTAMP_DIFF_USEC(stop, start);
+   char name[32];
+   snprintf(name, sizeof(name), "lookup/%s", msgType);
+   printf("%12s%12d%12d%10.3f\n", name, count * tagCount, total, (float)total * 1000 / ((float)count * tagCount));
+   assert(found == (int64_t)count * tagCount);
+}
+
+void scan_delimiter(int32_t simd, uint32_t valueLen)
+{
+   TIMESTAMP_INIT;
+   TIMESTAMP start, stop;
+
+   static char const* names[] = {"plain", "sse2", "avx2"};
+   int32_t const level = fix_utils_get_simd_level();
+   simd = fix_utils_set_simd_level(simd);
+
+   char buff[4096];
+   memset(buff, 'A', sizeof(buff));
+   for(uint32_t i = valueLen; i < sizeof(buff); i += valueLen + 1)
+   {
+      buff[i] = '|';
+   }
+
+   int32_t const count = 100000;
+   int64_t found = 0;
+
+   GET_TIMESTAMP(start);
+
+   for(int32_t i = 0; i < count; ++i)
+   {
+      char const* it = buff;
+      char const* end = buff + sizeof(buff);
+      while((it = fix_utils_find_char(it, end - it, '|')) != NULL)
+      {
+         ++it;
+         ++found;
+      }
+   }
+
+   GET_TIMESTAMP(stop);
+   fix_utils_set_simd_level(level);
+
+   int32_t const total = GET_TIMESTAMP_DIFF_USEC(stop, start);
+   char name[32];
+   snprintf(name, sizeof(name), "%s/%u", names[simd], valueLen);
+   printf("%12s%12d%12d%10.3f\n", name, count, total, (float)total * 1000 / ((float)count * sizeof(buff)));
+   assert(found > 0);
+}
+
+void checksum(int32_t simd, uint32_t msgLen)
+{
+   TIMESTAMP_INIT;
+   TIMESTAMP start, stop;
+
+   static char const* names[] = {"plain", "sse2", "avx2"};
+   int32_t const level = fix_utils_get_simd_level();
+   simd = fix_utils_set_simd_level(simd);
+
+   char buff[4096];
+   for(uint32_t i = 0; i < sizeof(buff); ++i)
+   {
+      buff[i] = (char)('0' + i % 61);
+   }
+
+   int32_t const count = 100000;
+   uint32_t crc = 0;
+
+   GET_TIMESTAMP(start);
+
+   for(int32_t i = 0; i < count; ++i)
+   {
+      for(char const* it = buff; it + msgLen <= buff + sizeof(buff); it += msgLen)
+      {
+         crc += fix_utils_checksum(it, msgLen);
+      }
+   }
+
+   GET_TIMESTAMP(stop);
+   fix_utils_set_simd_level(level);
+
+   int32_t const total = GET_TIMESTAMP_DIFF_USEC(stop, start);
+   char name[32];
+   snprintf(name, sizeof(name), "%s/%u", names[simd], msgLen);
+   printf("%12s%12d%12d%10.3f\n", name, count, total, (float)total * 1000 / ((float)count * sizeof(buff)));
+   assert(crc > 0);
+}
+
+void format_int(uint32_t digits)
+{
+   TIMESTAMP_INIT;
+   TIMESTAMP start, stop;
+
+   // values of given length with varying digits, so that no branch pattern is learned by heart
+   int64_t values[64];
+   int64_t const low = fix_utils_lpow10(digits - 1);
+   for(uint32_t i = 0; i < sizeof(values) / sizeof(values[0]); ++i)
+   {
+      values[i] = low + (int64_t)(i * 2654435761u) % (low * 9 > 1 ? low * 9 : 9);
+   }
+
+   char buff[32];
+   int32_t const count = 10000000;
+   int64_t written = 0;
+
+   GET_TIMESTAMP(start);
+
+   for(int32_t i = 0; i < count; ++i)
+   {
+      written += fix_utils_i64toa(values[i & 63], buff, sizeof(buff), 0);
+   }
+
+   GET_TIMESTAMP(stop);
+
+   int32_t const total = GET_TIMESTAMP_DIFF_USEC(stop, start);
+   char name[16];
+   snprintf(name, sizeof(name), "itoa/%u", digits);
+   printf("%12s%12d%12d%10.3f\n", name, count, total, (float)total * 1000 / count);
+   assert(written == (int64_t)count * digits);
+}
+
+void count_digits(void)
+{
+   TIMESTAMP_INIT;
+   TIMESTAMP start, stop;
+
+   int64_t values[64];
+   for(uint32_t i = 0; i < sizeof(values) / sizeof(values[0]); ++i)
+   {
+      values[i] = fix_utils_lpow10(i % 19) + i; // all lengths, as tags, sizes and body lengths are
+   }
+
+   int32_t const count = 10000000;
+   int64_t digits = 0;
+
+   GET_TIMESTAMP(start);
+
+   for(int32_t i = 0; i < count; ++i)
+   {
+      digits += fix_utils_numdigits(values[i & 63]);
+   }
+
+   GET_TIMESTAMP(stop);
+
+   int32_t const total = GET_TIMESTAMP_DIFF_USEC(stop, start);
+   printf("%12s%12d%12d%10.3f\n", "numdigits", count, total, (float)total * 1000 / count);
+   assert(digits > count);
+}
+
+void format_double(uint32_t shortest)
+{
+   TIMESTAMP_INIT;
+   TIMESTAMP start, stop;
+
+   // prices with 2..6 decimals and arbitrary doubles, which need all 17 digits
+   double values[64];
+   for(uint32_t i = 0; i < sizeof(values) / sizeof(values[0]); ++i)
+   {
+      values[i] = (i & 1) ? (double)(i * 2654435761u % 1000000) / fix_utils_lpow10(2 + i % 5) : 1.0 / (i + 3);
+   }
+
+   char buff[FIX_DTOA_BUFF_LEN];
+   int32_t const count = 2000000;
+   int64_t written = 0;
+
+   GET_TIMESTAMP(start);
+
+   for(int32_t i = 0; i < count; ++i)
+   {
+      if (shortest)
+      {
+         written += fix_utils_dtoa(values[i & 63], buff, sizeof(buff));
+      }
+      else
+      {
+         written += snprintf(buff, sizeof(buff), "%.17g", values[i & 63]);
+      }
+   }
+
+   GET_TIMESTAMP(stop);
+
+   int32_t const total = GET_TIMESTAMP_DIFF_USEC(stop, start);
+   printf("%12s%12d%12d%10.3f\n", shortest ? "dtoa" : "printf", count, total, (float)total * 1000 / count);
+   assert(written > count);
+}
+
+void price_path(uint32_t decimal)
+{
+   TIMESTAMP_INIT;
+   TIMESTAMP start, stop;
+
+   // parse price and format it back, as gateway does with limit prices
+   char prices[64][16];
+   uint32_t lens[64];
+   for(uint32_t i = 0; i < sizeof(prices) / sizeof(prices[0]); ++i)
+   {
+      lens[i] = snprintf(prices[i], sizeof(prices[i]), "%u.%0*u", i * 2654435761u % 100000, 2 + i % 4,
+            i * 40503u % (uint32_t)fix_utils_lpow10(2 + i % 4));
+   }
+
+   char buff[FIX_DTOA_BUFF_LEN];
+   int32_t const count = 2000000;
+   int64_t written = 0;
+
+   GET_TIMESTAMP(start);
+
+   for(int32_t i = 0; i < count; ++i)
+   {
+      int32_t cnt = 0;
+      if (decimal)
+      {
+         int64_t mantissa = 0;
+         int32_t exponent = 0;
+         fix_utils_atodec(prices[i & 63], lens[i & 63], 0, &mantissa, &exponent, &cnt);
+         written += fix_utils_dectoa(mantissa, exponent, buff, sizeof(buff));
+      }
+      else
+      {
+         double val = 0.0;
+         fix_utils_atod(prices[i & 63], lens[i & 63], 0, &val, &cnt);
+         written += fix_utils_dtoa_fixed(val, 2 + (i & 63) % 4, buff, sizeof(buff));
+      }
+   }
+
+   GET_TIMESTAMP(stop);
+
+   int32_t const total = GET_TIMESTAMP_DIFF_USEC(stop, start);
+   printf("%12s%12d%12d%10.3f\n", decimal ? "price/dec" : "price/dbl", count, total, (float)total * 1000 / count);
+   assert(written > count);
+}
+
+void check_double(void)
+{
+   // random bit patterns must be read back exactly, fixed precision must match printf for prices
+   uint64_t seed = 88172645463325252ull;
+   int32_t const count = 1000000;
+   int32_t roundTripFailed = 0;
+   int32_t fixedMismatch = 0;
+   char buff[FIX_DTOA_BUFF_LEN];
+   char buff2[FIX_DTOA_BUFF_LEN];
+   for(int32_t i = 0; i < count; ++i)
+   {
+      seed ^= seed << 13; seed ^= seed >> 7; seed ^= seed << 17;
+      double val = 0.0;
+      memcpy(&val, &seed, sizeof(val));
+      int32_t len = fix_utils_dtoa(val, buff, sizeof(buff));
+      buff[len] = 0;
+      if (len > 0 && strtod(buff, NULL) != val)
+      {
+         ++roundTripFailed;
+      }
+      double const price = (double)(seed % 100000000) / 10000;
+      len = fix_utils_dtoa_fixed(price, 4, buff, sizeof(buff));
+      buff[len] = 0;
+      snprintf(buff2, sizeof(buff2), "%.4f", price);
+      if (strcmp(buff, buff2))
+      {
+         ++fixedMismatch;
+      }
+   }
+   printf("%12s%12d%12d\n", "roundtrip", count, roundTripFailed);
+   printf("%12s%12d%12d\n", "fixed/%.4f", count, fixedMismatch);
+}
+
+int main(int argc, char *argv[])
+{
+   if (argc == 1)
+   {
+      printf("perf_test <prot_file.xml>\n");
+      return 1;
+   }
+
+   FIXError* error = NULL;
+   FIXParser* parser = fix_parser_create(argv[1], NULL, PARSER_FLAG_CHECK_ALL, &error);
+   if (!parser)
+   {
+      printf("ERROR: %s\n", fix_error_get_text(error));
+      free(error);
+      return 1;
+   }
+
+   printf("%12s%12s%12s%12s", "test", "count", "total", "per msg\n");
+   create_msg(parser);
+   update_msg(parser);
+   msg_to_str(parser);
+   str_to_msg(parser);
+   str_to_msg_into(parser);
+   str_to_view(parser);
+   str_to_msgs(parser);
+   str_to_proj(parser);
+   md_refresh(parser, 4);
+   md_refresh(parser, 32);
+   serialize(parser, 1);
+   serialize(parser, 32);
+   send_msg(parser, 0);
+   send_msg(parser, 1);
+   peek();
+   frame_stream(64);
+   frame_stream(1460);
+
+#ifndef WIN32
+   printf("%12s%12s%12s%12s", "mt/threads", "count", "total", "per msg\n");
+   uint32_t const threadCounts[] = {1, 2, 4, 8};
+   for(uint32_t i = 0; i < sizeof(threadCounts) / sizeof(threadCounts[0]); ++i)
+   {
+      str_to_msg_mt(parser, threadCounts[i]);
+   }
+#endif
+
+   printf("%12s%12s%12s%12s%12s", "live msgs", "count", "total", "per msg", "RSS, KB\n");
+   live_msgs(argv[1], 0, "pages");
+   live_msgs(argv[1], 64 * 1024, "arena");
+
+   printf("%12s%12s%12s%12s%14s", "pool", "count", "total", "per msg", "dTLB misses\n");
+   pool_walk(argv[1], 0, 0, "calloc");
+   pool_walk(argv[1], POOL_FLAG_SLAB, 0, "slab");
+   pool_walk(argv[1], POOL_FLAG_SLAB | POOL_FLAG_PREFAULT, 0, "slab+fault");
+   pool_walk(argv[1], POOL_FLAG_HUGE_PAGES | POOL_FLAG_PREFAULT, 0, "huge+fault");
+
+#ifdef __linux__
+   printf("%12s%12s%12s%12s%14s", "numa/node", "count", "total", "per msg", "dTLB misses\n");
+   numa_walk(argv[1]);
+#endif
+
+   printf("%12s%12s%12s%12s", "lookup/msg", "count", "total", "ns/field\n");
+   field_lookup(parser, "8");
+
+   printf("%12s%12s%12s%12s", "scan/len", "count", "total", "ns/byte\n");
+   uint32_t const valueLens[] = {4, 16, 64, 256};
+   for(uint32_t i = 0; i < sizeof(valueLens) / sizeof(valueLens[0]); ++i)
+   {
+      for(int32_t simd = FIX_SIMD_NONE; simd <= FIX_SIMD_AVX2; ++simd)
+      {
+         scan_delimiter(simd, valueLens[i]);
+      }
+   }
+
+   printf("%12s%12s%12s%12s", "crc/len", "count", "total", "ns/byte\n");
+   uint32_t const msgLens[] = {64, 256, 1024};
+   for(uint32_t i = 0; i < sizeof(msgLens) / sizeof(msgLens[0]); ++i)
+   {
+      for(int32_t simd = FIX_SIMD_NONE; simd <= FIX_SIMD_AVX2; ++simd)
+      {
+         checksum(simd, msgLens[i]);
+      }
+   }
+
+   printf("%12s%12s%12s%12s", "format", "count", "total", "ns/value\n");
+   uint32_t const intDigits[] = {1, 3, 6, 9, 12, 18};
+   for(uint32_t i = 0; i < sizeof(intDigits) / sizeof(intDigits[0]); ++i)
+   {
+      format_int(intDigits[i]);
+   }
+   count_digits();
+   format_double(1);
+   format_double(0);
+   price_path(1);
+   price_path(0);
+
+   printf("%12s%12s%12s\n", "double", "count", "failed");
+   check_double();
 
    fix_parser_free(parser);
 
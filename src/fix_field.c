@@ -14,7 +14,8 @@
 #include <string.h>
 #include <assert.h>
 
-static FIXField* fix_field_free(FIXMsg* msg, FIXField* field);
+static FIXField* fix_field_put(FIXMsg* msg, FIXGroup* grp, FIXFieldDescr const* descr, uint32_t len, FIXError** error);
+static void fix_field_free(FIXMsg* msg, FIXField* field);
 static void fix_group_free(FIXMsg* msg, FIXGroup* group);
 
 /*-----------------------------------------------------------------------------------------------------------------------*/
@@ -23,98 +24,83 @@ static void fix_group_free(FIXMsg* msg, FIXGroup* group);
 FIXField* fix_field_set(FIXMsg* msg, FIXGroup* grp, FIXFieldDescr const* descr, unsigned char const* data, uint32_t len,
       FIXError** error)
 {
-   FIXField* field = fix_field_get(msg, grp, descr->type->tag);
-   if (field && field->descr->category == FIXFieldCategory_Group)
+   FIXField* field = fix_field_put(msg, grp, descr, len, error);
+   if (!field)
    {
-      *error = fix_error_create(FIX_ERROR_FIELD_HAS_WRONG_TYPE, "FIXField has wrong type");
       return NULL;
    }
-   int32_t idx = descr->type->tag % GROUP_SIZE;
-   if (!field)
+   if (!field->data || (field->flags & FIELD_FLAG_DATA_REF))
    {
-      field = (FIXField*)fix_msg_alloc(msg, sizeof(FIXField), error);
-      if (!field)
-      {
-         return NULL;
-      }
-      field->descr = descr;
-      FIXGroup* group = (grp ? grp : msg->fields);
-      field->next = group->fields[idx];
-      group->fields[idx] = field;
-      field->size = len;
       field->data = (char*)fix_msg_alloc(msg, len, error);
-      field->body_len = 0;
+      field->flags &= ~FIELD_FLAG_DATA_REF;
    }
    else
    {
-      field->size = len;
       field->data = (char*)fix_msg_realloc(msg, field->data, len, error);
-      msg->body_len -= field->body_len;
    }
    if (!field->data)
    {
       return NULL;
    }
-   if (LIKE(field->descr->type->tag != FIXFieldTag_BeginString &&
-            field->descr->type->tag != FIXFieldTag_BodyLength &&
-            field->descr->type->tag != FIXFieldTag_CheckSum))
-   {
-      field->body_len = fix_utils_numdigits(descr->type->tag) + 1 + len + 1;
-   }
    memcpy(field->data, data, len);
-   msg->body_len += field->body_len;
    return field;
 }
 
 /*------------------------------------------------------------------------------------------------------------------------*/
-FIXField* fix_field_get(FIXMsg* msg, FIXGroup* grp, FIXTagNum tag)
+FIXField* fix_field_set_ref(FIXMsg* msg, FIXGroup* grp, FIXFieldDescr const* descr, char const* data, uint32_t len,
+      FIXError** error)
 {
-   uint32_t const idx = tag % GROUP_SIZE;
-   FIXField* it = (grp ? grp : msg->fields)->fields[idx];
-   while(it)
+   FIXField* field = fix_field_put(msg, grp, descr, len, error);
+   if (!field)
    {
-      if (it->descr->type->tag == tag)
-      {
-         return it;
-      }
-      it = it->next;
+      return NULL;
+   }
+   if (field->data && !(field->flags & FIELD_FLAG_DATA_REF))
+   {
+      fix_msg_free_block(msg, field->data);
    }
-   return it;
+   field->data = (char*)data;
+   field->flags |= FIELD_FLAG_DATA_REF;
+   return field;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+FIXField* fix_field_get(FIXMsg* msg, FIXGroup* grp, FIXTagNum tag)
+{
+   FIXGroup* group = grp ? grp : msg->fields;
+   FIXFieldDescr const* descr = group->parent_fdescr ? fix_protocol_get_group_descr(group->parent_fdescr, tag)
+      : fix_protocol_get_field_descr(msg->descr, tag);
+   return descr && GROUP_SLOT_USED(group, descr->ordinal) ? group->fields[descr->ordinal] : NULL;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+FIXField* fix_field_get_by_descr(FIXMsg* msg, FIXGroup* grp, FIXFieldDescr const* descr)
+{
+   FIXGroup* group = grp ? grp : msg->fields;
+   assert(descr->ordinal < group->field_count);
+   return GROUP_SLOT_USED(group, descr->ordinal) ? group->fields[descr->ordinal] : NULL;
 }
 
 /*------------------------------------------------------------------------------------------------------------------------*/
 FIXErrCode fix_field_del(FIXMsg* msg, FIXGroup* grp, FIXTagNum tag, FIXError** error)
 {
-   uint32_t const idx = tag % GROUP_SIZE;
    FIXGroup* group = grp ? grp : msg->fields;
-   FIXField* field = group->fields[idx];
-   FIXField* prev = field;
-   while(field)
+   FIXField* field = fix_field_get(msg, group, tag);
+   if (!field)
    {
-      if (field->descr->type->tag == tag)
-      {
-         if (prev == field)
-         {
-            group->fields[idx] = fix_field_free(msg, field);
-         }
-         else
-         {
-            prev->next = fix_field_free(msg, field);
-         }
-         return FIX_SUCCESS;
-      }
-      prev = field;
-      field = field->next;
+      *error = fix_error_create(FIX_ERROR_FIELD_NOT_FOUND, "FIXField not found");
+      return FIX_FAILED;
    }
-   *error = fix_error_create(FIX_ERROR_FIELD_NOT_FOUND, "FIXField not found");
-   return FIX_FAILED;
+   group->fields[field->descr->ordinal] = NULL;
+   GROUP_SLOT_CLEAR(group, field->descr->ordinal);
+   fix_field_free(msg, field);
+   return FIX_SUCCESS;
 }
 
 /*------------------------------------------------------------------------------------------------------------------------*/
 FIXGroup* fix_group_add(FIXMsg* msg, FIXGroup* grp, FIXFieldDescr const* descr, FIXField** fld, FIXError** error)
 {
-   FIXField* field = fix_field_get(msg, grp, descr->type->tag);
-   FIXGroup* group = grp ? grp : msg->fields;
+   FIXField* field = fix_field_get_by_descr(msg, grp, descr);
    if (field && field->descr->category != FIXFieldCategory_Group)
    {
       *error = fix_error_create(FIX_ERROR_FIELD_HAS_WRONG_TYPE, "FIXField has wrong type");
@@ -122,12 +108,16 @@ FIXGroup* fix_group_add(FIXMsg* msg, FIXGroup* grp, FIXFieldDescr const* descr,
    }
    if (!field)
    {
-      uint32_t const idx = descr->type->tag % GROUP_SIZE;
       field = (FIXField*)fix_msg_alloc(msg, sizeof(FIXField), error);
-      assert(field);
+      if (!field)
+      {
+         return NULL;
+      }
       field->descr = descr;
-      field->next = group->fields[idx];
-      group->fields[idx] = field;
+      FIXGroup* group = grp ? grp : msg->fields;
+      group->fields[descr->ordinal] = field;
+      GROUP_SLOT_SET(group, descr->ordinal);
+      field->flags = 0;
       field->data = (char*)fix_msg_alloc(msg, sizeof(FIXGroups), error);
       if (!field->data)
       {
@@ -136,7 +126,7 @@ FIXGroup* fix_group_add(FIXMsg* msg, FIXGroup* grp, FIXFieldDescr const* descr,
       FIXGroups* grps = (FIXGroups*)field->data;
       field->size = 1;
       field->body_len = 0;
-      grps->group[0] = fix_msg_alloc_group(msg, error);
+      grps->group[0] = fix_msg_alloc_group(msg, descr, error);
       if (!grps->group[0])
       {
          return NULL;
@@ -145,10 +135,9 @@ FIXGroup* fix_group_add(FIXMsg* msg, FIXGroup* grp, FIXFieldDescr const* descr,
    else
    {
       FIXGroups* grps = (FIXGroups*)field->data;
-      FIXGroups* new_grps = (FIXGroups*)fix_msg_realloc(msg, field->data, sizeof(FIXGroups) + sizeof(FIXGroup*) * (field->size + 1), error);
+      FIXGroups* new_grps = (FIXGroups*)fix_msg_realloc(msg, grps, sizeof(FIXGroups) + sizeof(FIXGroup*) * (field->size + 1), error);
       assert(new_grps);
-      memcpy(new_grps->group, grps->group, sizeof(FIXGroup*) * (field->size));
-      new_grps->group[field->size] = fix_msg_alloc_group(msg, error);
+      new_grps->group[field->size] = fix_msg_alloc_group(msg, descr, error);
       if (!new_grps->group[field->size])
       {
          return NULL;
@@ -173,32 +162,23 @@ FIXGroup* fix_group_add(FIXMsg* msg, FIXGroup* grp, FIXFieldDescr const* descr,
 /*------------------------------------------------------------------------------------------------------------------------*/
 FIXGroup* fix_group_get(FIXMsg* msg, FIXGroup* grp, FIXTagNum tag, uint32_t grpIdx, FIXError** error)
 {
-   int32_t const idx = tag % GROUP_SIZE;
-   FIXGroup* group = (grp ? grp : msg->fields);
-   FIXField* it = group->fields[idx];
-   while(it)
+   FIXField* it = fix_field_get(msg, grp, tag);
+   if (!it)
    {
-      if (it->descr->type->tag == tag)
-      {
-         if (it->descr->category != FIXFieldCategory_Group)
-         {
-            *error = fix_error_create(FIX_ERROR_FIELD_HAS_WRONG_TYPE, "FIXField has wrong type");
-            return NULL;
-         }
-         FIXGroups* grps = (FIXGroups*)it->data;
-         if (grpIdx >= it->size)
-         {
-            *error = fix_error_create(FIX_ERROR_GROUP_WRONG_INDEX, "Wrong index");
-            return NULL;
-         }
-         return grps->group[grpIdx];
-      }
-      else
-      {
-         it = it->next;
-      }
+      return NULL;
+   }
+   if (it->descr->category != FIXFieldCategory_Group)
+   {
+      *error = fix_error_create(FIX_ERROR_FIELD_HAS_WRONG_TYPE, "FIXField has wrong type");
+      return NULL;
+   }
+   FIXGroups* grps = (FIXGroups*)it->data;
+   if (grpIdx >= it->size)
+   {
+      *error = fix_error_create(FIX_ERROR_GROUP_WRONG_INDEX, "Wrong index");
+      return NULL;
    }
-   return NULL;
+   return grps->group[grpIdx];
 }
 
 /*------------------------------------------------------------------------------------------------------------------------*/
@@ -243,7 +223,46 @@ FIXErrCode fix_group_del(FIXMsg* msg, FIXGroup* grp, FIXTagNum tag, uint32_t grp
 /*------------------------------------------------------------------------------------------------------------------------*/
 /* PRIVATES                                                                                                               */
 /*------------------------------------------------------------------------------------------------------------------------*/
-static FIXField* fix_field_free(FIXMsg* msg, FIXField* field)
+static FIXField* fix_field_put(FIXMsg* msg, FIXGroup* grp, FIXFieldDescr const* descr, uint32_t len, FIXError** error)
+{
+   FIXField* field = fix_field_get_by_descr(msg, grp, descr);
+   if (field && field->descr->category == FIXFieldCategory_Group)
+   {
+      *error = fix_error_create(FIX_ERROR_FIELD_HAS_WRONG_TYPE, "FIXField has wrong type");
+      return NULL;
+   }
+   if (!field)
+   {
+      field = (FIXField*)fix_msg_alloc(msg, sizeof(FIXField), error);
+      if (!field)
+      {
+         return NULL;
+      }
+      field->descr = descr;
+      FIXGroup* group = grp ? grp : msg->fields;
+      group->fields[descr->ordinal] = field;
+      GROUP_SLOT_SET(group, descr->ordinal);
+      field->flags = 0;
+      field->data = NULL;
+      field->body_len = 0;
+   }
+   else
+   {
+      msg->body_len -= field->body_len;
+   }
+   field->size = len;
+   if (LIKE(field->descr->type->tag != FIXFieldTag_BeginString &&
+            field->descr->type->tag != FIXFieldTag_BodyLength &&
+            field->descr->type->tag != FIXFieldTag_CheckSum))
+   {
+      field->body_len = fix_utils_numdigits(descr->type->tag) + 1 + len + 1;
+   }
+   msg->body_len += field->body_len;
+   return field;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+static void fix_field_free(FIXMsg* msg, FIXField* field)
 {
    if (field->descr->category == FIXFieldCategory_Group)
    {
@@ -254,19 +273,24 @@ static FIXField* fix_field_free(FIXMsg* msg, FIXField* field)
       }
    }
    msg->body_len -= field->body_len;
-   return field->next;
+   // field space goes to message free list
+   if (field->data && !(field->flags & FIELD_FLAG_DATA_REF))
+   {
+      fix_msg_free_block(msg, field->data);
+   }
+   fix_msg_free_block(msg, field);
 }
 
 /*------------------------------------------------------------------------------------------------------------------------*/
 static void fix_group_free(FIXMsg* msg, FIXGroup* group)
 {
-   for(int32_t i = 0; i < GROUP_SIZE; ++i)
+   for(uint32_t w = 0; w < GROUP_USED_WORDS(group->field_count); ++w)
    {
-      FIXField* tag = group->fields[i];
-      while(tag)
+      for(uint64_t bits = group->used[w]; bits; bits &= bits - 1)
       {
-         tag = fix_field_free(msg, tag);
+         fix_field_free(msg, group->fields[w * 64 + CTZ64(bits)]);
       }
    }
+   fix_msg_free_block(msg, group->fields);
    fix_msg_free_group(msg, group);
 }
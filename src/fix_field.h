@@ -21,7 +21,12 @@ extern "C"
 {
 #endif
 
-#define GROUP_SIZE 64
+#define FIELD_FLAG_DATA_REF 0x01 ///< field data is not owned by message, it references parsed buffer
+
+#define GROUP_USED_WORDS(count)     (((count) + 63) / 64)                            ///< size of occupancy bitmap in words
+#define GROUP_SLOT_USED(grp, ord)   (((grp)->used[(ord) >> 6] >> ((ord) & 63)) & 1)  ///< non-zero, if slot holds a field
+#define GROUP_SLOT_SET(grp, ord)    ((grp)->used[(ord) >> 6] |= (uint64_t)1 << ((ord) & 63))
+#define GROUP_SLOT_CLEAR(grp, ord)  ((grp)->used[(ord) >> 6] &= ~((uint64_t)1 << ((ord) & 63)))
 
 /**
  * FIX field
@@ -29,9 +34,9 @@ extern "C"
 struct FIXField_
 {
    FIXFieldDescr const* descr; ///< FIX field description
-   struct FIXField_* next;     ///< next FIX field with the same hash key
    uint32_t body_len;          ///< length of field, if it is converted to string
    uint32_t size;              ///< size of field data
+   uint8_t flags;              ///< FIELD_FLAG_DATA_REF
    char* data;                 ///< field value. All values converted to string
 };
 
@@ -40,9 +45,11 @@ struct FIXField_
  */
 struct FIXGroup_
 {
-   FIXField* fields[GROUP_SIZE]; ///< FIX field hash table
+   FIXField** fields;                  ///< FIX fields indexed by FIXFieldDescr::ordinal. Valid only if slot bit is set in used
+   uint64_t* used;                     ///< occupancy bitmap of fields. Only bitmap is cleared, when group is (re)allocated
+   uint32_t field_count;               ///< count of slots in fields
    FIXFieldDescr const* parent_fdescr; ///< description of FIX field, which defines number of entries on group
-   struct FIXGroup_* next;   ///< next group in pool of unused groups. If this group is used next == NULL
+   struct FIXGroup_* next;             ///< next group in pool of unused groups. If this group is used next == NULL
 };
 
 /**
@@ -65,6 +72,18 @@ typedef struct FIXGroups_
  */
 FIXField* fix_field_set(FIXMsg* msg, FIXGroup* grp, FIXFieldDescr const* descr, unsigned char const* data, uint32_t len, FIXError** error);
 
+/**
+ * set FIX field value without copying it. Field references data, so data must live as long as the field
+ * @param[in] msg    - FIX message
+ * @param[in] grp    - FIX group, if FIX field is a part of FIX group, else must be NULL
+ * @param[in] descr  - FIX field description
+ * @param[in] data   - FIX field value
+ * @param[in] len    - value length
+ * @param[out] error - error description
+ * @return pointer to changed FIX field, NULL in case of error
+ */
+FIXField* fix_field_set_ref(FIXMsg* msg, FIXGroup* grp, FIXFieldDescr const* descr, char const* data, uint32_t len, FIXError** error);
+
 /**
  * return FIX field by tag number
  * @param[in] msg - FIX message with required field
@@ -74,6 +93,15 @@ FIXField* fix_field_set(FIXMsg* msg, FIXGroup* grp, FIXFieldDescr const* descr,
  */
 FIXField* fix_field_get(FIXMsg* msg, FIXGroup* grp, FIXTagNum tag);
 
+/**
+ * return FIX field by its description
+ * @param[in] msg   - FIX message with required field
+ * @param[in] grp   - FIX group, if required FIX field is a part of FIX group
+ * @param[in] descr - FIX field description, taken from message or group description
+ * @return required FIX field, NULL - field is not set
+ */
+FIXField* fix_field_get_by_descr(FIXMsg* msg, FIXGroup* grp, FIXFieldDescr const* descr);
+
 /**
  * delete FIX field by tag number
  * @param[in] msg - FIX message, with deleted FIX field
@@ -0,0 +1,213 @@
+/**
+ * @file   fix_framer.c
+ * @date   Created on: 10/17/2026 10:12:40 AM
+ */
+
+#include "fix_framer.h"
+#include "fix_utils.h"
+#include "fix_error_priv.h"
+
+#include <stdlib.h>
+
+#define MAX_BODY_LEN_DIGITS 9
+#define CHECKSUM_FIELD_LEN 7 ///< "10=NNN" and delimiter
+
+typedef enum FIXFramerStage
+{
+   FIXFramerStage_BeginString,
+   FIXFramerStage_BodyLength,
+   FIXFramerStage_Body,
+   FIXFramerStage_CheckSum
+} FIXFramerStage;
+
+/**
+ * FIX stream framer
+ */
+struct FIXFramer_
+{
+   char delimiter;            ///< FIX SOH
+   uint32_t maxMsgLen;        ///< max allowed message length, 0 - unlimited
+   FIXFramerStage stage;      ///< field of current message being framed
+   uint32_t offset;           ///< count of already processed bytes of current message
+   uint32_t fieldOffset;      ///< offset of current field (or body for FIXFramerStage_Body)
+   uint32_t bodyLen;          ///< BodyLength value
+   uint32_t bodyLenDigits;    ///< count of processed BodyLength digits
+};
+
+static FIXErrCode fix_framer_check_tag(
+      FIXFramer* framer, char const* data, uint32_t len, char const* tag, uint32_t tagLen, FIXError** error);
+static FIXErrCode fix_framer_find_delimiter(FIXFramer* framer, char const* data, uint32_t len, FIXError** error);
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+/* PUBLICS                                                                                                                */
+/*------------------------------------------------------------------------------------------------------------------------*/
+FIX_PARSER_API FIXFramer* fix_framer_create(char delimiter, uint32_t maxMsgLen)
+{
+   FIXFramer* framer = (FIXFramer*)calloc(1, sizeof(FIXFramer));
+   if (!framer)
+   {
+      return NULL;
+   }
+   framer->delimiter = delimiter;
+   framer->maxMsgLen = maxMsgLen;
+   fix_framer_reset(framer);
+   return framer;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+FIX_PARSER_API void fix_framer_free(FIXFramer* framer)
+{
+   free(framer);
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+FIX_PARSER_API void fix_framer_reset(FIXFramer* framer)
+{
+   if (!framer)
+   {
+      return;
+   }
+   framer->stage = FIXFramerStage_BeginString;
+   framer->offset = 0;
+   framer->fieldOffset = 0;
+   framer->bodyLen = 0;
+   framer->bodyLenDigits = 0;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+FIX_PARSER_API FIXErrCode fix_framer_next(FIXFramer* framer, char const* data, uint32_t len, uint32_t* msgLen, FIXError** error)
+{
+   if (!framer || !data || !msgLen)
+   {
+      return FIX_FAILED;
+   }
+   FIXErrCode res = FIX_SUCCESS;
+   switch(framer->stage)
+   {
+      case FIXFramerStage_BeginString:
+         if ((res = fix_framer_check_tag(framer, data, len, "8=", 2, error)) != FIX_SUCCESS ||
+             (res = fix_framer_find_delimiter(framer, data, len, error)) != FIX_SUCCESS)
+         {
+            return res;
+         }
+         framer->stage = FIXFramerStage_BodyLength;
+         framer->fieldOffset = framer->offset;
+         // fall through
+      case FIXFramerStage_BodyLength:
+         if ((res = fix_framer_check_tag(framer, data, len, "9=", 2, error)) != FIX_SUCCESS)
+         {
+            return res;
+         }
+         for(; framer->offset < len; ++framer->offset)
+         {
+            char const ch = data[framer->offset];
+            if (ch == framer->delimiter)
+            {
+               break;
+            }
+            if (ch < '0' || ch > '9' || framer->bodyLenDigits == MAX_BODY_LEN_DIGITS)
+            {
+               *error = fix_error_create(FIX_ERROR_INVALID_ARGUMENT, "BodyLength value is not a number.");
+               return FIX_FAILED;
+            }
+            framer->bodyLen = framer->bodyLen * 10 + (ch - '0');
+            ++framer->bodyLenDigits;
+         }
+         if (framer->offset == len)
+         {
+            return FIX_ERROR_NO_MORE_DATA;
+         }
+         if (!framer->bodyLenDigits || !framer->bodyLen)
+         {
+            *error = fix_error_create(FIX_ERROR_INVALID_ARGUMENT, "BodyLength value is empty or zero.");
+            return FIX_FAILED;
+         }
+         ++framer->offset;
+         if (framer->maxMsgLen && framer->offset + framer->bodyLen + CHECKSUM_FIELD_LEN > framer->maxMsgLen)
+         {
+            *error = fix_error_create(FIX_ERROR_PARSE_MSG, "Message is too long. BodyLength = %u, MaxMsgLen = %u.",
+                  framer->bodyLen, framer->maxMsgLen);
+            return FIX_FAILED;
+         }
+         framer->stage = FIXFramerStage_Body;
+         framer->fieldOffset = framer->offset;
+         // fall through
+      case FIXFramerStage_Body:
+         // body is skipped without scanning, only its last delimiter is checked
+         if (len < framer->fieldOffset + framer->bodyLen)
+         {
+            framer->offset = len;
+            return FIX_ERROR_NO_MORE_DATA;
+         }
+         framer->offset = framer->fieldOffset + framer->bodyLen;
+         if (data[framer->offset - 1] != framer->delimiter)
+         {
+            *error = fix_error_create(FIX_ERROR_INTEGRITY_CHECK, "BodyLength %u doesn't match message body.", framer->bodyLen);
+            return FIX_FAILED;
+         }
+         framer->stage = FIXFramerStage_CheckSum;
+         framer->fieldOffset = framer->offset;
+         // fall through
+      case FIXFramerStage_CheckSum:
+         if ((res = fix_framer_check_tag(framer, data, len, "10=", 3, error)) != FIX_SUCCESS)
+         {
+            return res;
+         }
+         // CheckSum value is always three digits, so trailer is already covered by maxMsgLen check
+         for(; framer->offset < framer->fieldOffset + CHECKSUM_FIELD_LEN && framer->offset < len; ++framer->offset)
+         {
+            char const ch = data[framer->offset];
+            int32_t const last = (framer->offset == framer->fieldOffset + CHECKSUM_FIELD_LEN - 1);
+            if (last ? ch != framer->delimiter : (ch < '0' || ch > '9'))
+            {
+               *error = fix_error_create(FIX_ERROR_INTEGRITY_CHECK, "CheckSum value is not three digits.");
+               return FIX_FAILED;
+            }
+         }
+         if (framer->offset < framer->fieldOffset + CHECKSUM_FIELD_LEN)
+         {
+            return FIX_ERROR_NO_MORE_DATA;
+         }
+         *msgLen = framer->offset;
+         fix_framer_reset(framer);
+         return FIX_SUCCESS;
+   }
+   return FIX_FAILED;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+/* PRIVATES                                                                                                               */
+/*------------------------------------------------------------------------------------------------------------------------*/
+static FIXErrCode fix_framer_check_tag(
+      FIXFramer* framer, char const* data, uint32_t len, char const* tag, uint32_t tagLen, FIXError** error)
+{
+   uint32_t const tagEnd = framer->fieldOffset + tagLen;
+   for(; framer->offset < tagEnd && framer->offset < len; ++framer->offset)
+   {
+      if (data[framer->offset] != tag[framer->offset - framer->fieldOffset])
+      {
+         *error = fix_error_create(FIX_ERROR_WRONG_FIELD, "Field '%.*s' expected at position %u.",
+               (int)(tagLen - 1), tag, framer->fieldOffset);
+         return FIX_FAILED;
+      }
+   }
+   return framer->offset >= tagEnd ? FIX_SUCCESS : FIX_ERROR_NO_MORE_DATA;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+static FIXErrCode fix_framer_find_delimiter(FIXFramer* framer, char const* data, uint32_t len, FIXError** error)
+{
+   char const* end = fix_utils_find_char(data + framer->offset, len - framer->offset, framer->delimiter);
+   if (!end)
+   {
+      framer->offset = len;
+      if (framer->maxMsgLen && framer->offset > framer->maxMsgLen)
+      {
+         *error = fix_error_create(FIX_ERROR_PARSE_MSG, "Message is too long. MaxMsgLen = %u.", framer->maxMsgLen);
+         return FIX_FAILED;
+      }
+      return FIX_ERROR_NO_MORE_DATA;
+   }
+   framer->offset = end - data + 1;
+   return FIX_SUCCESS;
+}
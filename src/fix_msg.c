@@ -44,27 +44,78 @@ FIX_PARSER_API FIXMsg* fix_msg_create(FIXParser* parser, char const* msgType, FI
    {
       return NULL;
    }
-   FIXMsg* msg = (FIXMsg*)malloc(sizeof(FIXMsg));
-   msg->fields = msg->used_groups = fix_parser_alloc_group(parser, error);
-   if (!msg->fields)
+   return fix_msg_create_by_descr(parser, msg_descr, error);
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+FIXMsg* fix_msg_create_by_descr(FIXParser* parser, FIXMsgDescr const* msg_descr, FIXError** error)
+{
+   FIXMsg* msg = fix_parser_alloc_msg(parser, error);
+   if (!msg)
    {
-      fix_msg_free(msg);
       return NULL;
    }
-   msg->descr = msg_descr;
    msg->parser = parser;
-   msg->pages = msg->curr_page = fix_parser_alloc_page(parser, 0, error);
-   if (!msg->pages)
+   msg->descr = NULL;
+   msg->used_groups = msg->free_groups = NULL;
+   msg->pages = msg->curr_page = fix_parser_alloc_chunk(parser, 0, fix_parser_msg_page_size(parser, msg_descr), error);
+   if (!msg->pages || fix_msg_reset_by_descr(msg, msg_descr, error) == FIX_FAILED)
    {
       fix_msg_free(msg);
       return NULL;
    }
-   msg->body_len = 0;
-   fix_msg_set_string(msg, NULL, 8, parser->protocol->transportVersion, error);
-   fix_msg_set_string(msg, NULL, 35, msgType, error);
    return msg;
 }
 
+/*------------------------------------------------------------------------------------------------------------------------*/
+FIX_PARSER_API FIXErrCode fix_msg_reset(FIXMsg* msg, FIXError** error)
+{
+   if (!msg)
+   {
+      return FIX_FAILED;
+   }
+   return fix_msg_reset_by_descr(msg, msg->descr, error);
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+FIXErrCode fix_msg_reset_by_descr(FIXMsg* msg, FIXMsgDescr const* msg_descr, FIXError** error)
+{
+   uint32_t used = 0;
+   for(FIXPage* page = msg->pages; page; page = page->next)
+   {
+      used += page->offset;
+      page->offset = 0;
+   }
+   if (msg->descr && used)
+   {
+      fix_parser_update_msg_stats(msg->parser, msg->descr, used);
+   }
+   msg->curr_page = msg->pages;
+   memset(msg->free_blocks, 0, sizeof(msg->free_blocks));
+   msg->free_mask = 0;
+   while(msg->used_groups)
+   {
+      FIXGroup* grp = msg->used_groups;
+      msg->used_groups = grp->next;
+      grp->next = msg->free_groups;
+      msg->free_groups = grp;
+   }
+   msg->descr = msg_descr;
+   msg->body_len = 0;
+   msg->flags = 0;
+   msg->fields = fix_msg_alloc_group(msg, NULL, error);
+   if (!msg->fields)
+   {
+      return FIX_FAILED;
+   }
+   if (fix_msg_set_string(msg, NULL, FIXFieldTag_BeginString, msg->parser->protocol->transportVersion, error) == FIX_FAILED ||
+       fix_msg_set_string(msg, NULL, FIXFieldTag_MsgType, msg_descr->type, error) == FIX_FAILED)
+   {
+      return FIX_FAILED;
+   }
+   return FIX_SUCCESS;
+}
+
 /*------------------------------------------------------------------------------------------------------------------------*/
 FIX_PARSER_API void fix_msg_free(FIXMsg* msg)
 {
@@ -72,18 +123,29 @@ FIX_PARSER_API void fix_msg_free(FIXMsg* msg)
    {
       return;
    }
+   uint32_t used = 0;
    FIXPage* page = msg->pages;
    while(page)
    {
+      used += page->offset;
       page = fix_parser_free_page(msg->parser, page);
    }
+   if (msg->descr && used)
+   {
+      fix_parser_update_msg_stats(msg->parser, msg->descr, used);
+   }
    FIXGroup* grp = msg->used_groups;
    while(grp)
    {
       grp = fix_parser_free_group(msg->parser, grp);
 
    }
-   free(msg);
+   grp = msg->free_groups;
+   while(grp)
+   {
+      grp = fix_parser_free_group(msg->parser, grp);
+   }
+   fix_parser_free_msg(msg->parser, msg);
 }
 
 /*------------------------------------------------------------------------------------------------------------------------*/
@@ -126,7 +188,6 @@ FIX_PARSER_API FIXGroup* fix_msg_add_group(FIXMsg* msg, FIXGroup* grp, FIXTagNum
 
    FIXField* field = NULL;
    FIXGroup* new_grp = fix_group_add(msg, grp, fdescr, &field, error);
-   new_grp->parent_fdescr = fdescr;
    return new_grp;
 }
 
@@ -282,8 +343,78 @@ FIX_PARSER_API FIXErrCode fix_msg_set_double(FIXMsg* msg, FIXGroup* grp, FIXTagN
       *error = fix_error_create(FIX_ERROR_FIELD_HAS_WRONG_TYPE, "Tag '%d' type is not compatrible with value '%f'", tag, val);
       return FIX_FAILED;
    }
-   char buff[64] = {};
+   char buff[FIX_DTOA_BUFF_LEN];
    int32_t res = fix_utils_dtoa(val, buff, sizeof(buff));
+   if (!res)
+   {
+      *error = fix_error_create(FIX_ERROR_WRONG_FIELD_VALUE, "Tag '%d' value '%f' is not a finite number", tag, val);
+      return FIX_FAILED;
+   }
+   FIXField* field = fix_msg_set_field(msg, grp, fdescr, (unsigned char*)buff, res, error);
+   return field != NULL ? FIX_SUCCESS : FIX_FAILED;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+FIX_PARSER_API FIXErrCode fix_msg_set_double_fixed(FIXMsg* msg, FIXGroup* grp, FIXTagNum tag, double val, uint32_t precision,
+      FIXError** error)
+{
+   if (!msg)
+   {
+      return FIX_FAILED;
+   }
+   FIXFieldDescr const* fdescr = fix_protocol_get_descr(msg, grp, tag, error);
+   if (!fdescr)
+   {
+      return FIX_FAILED;
+   }
+   if (!IS_FLOAT_TYPE(fdescr->type->valueType))
+   {
+      *error = fix_error_create(FIX_ERROR_FIELD_HAS_WRONG_TYPE, "Tag '%d' type is not compatrible with value '%f'", tag, val);
+      return FIX_FAILED;
+   }
+   if (precision > FIX_DTOA_MAX_PRECISION)
+   {
+      *error = fix_error_create(FIX_ERROR_INVALID_ARGUMENT, "Precision %u is greater than %d", precision, FIX_DTOA_MAX_PRECISION);
+      return FIX_FAILED;
+   }
+   char buff[FIX_DTOA_BUFF_LEN];
+   int32_t res = fix_utils_dtoa_fixed(val, precision, buff, sizeof(buff));
+   if (!res)
+   {
+      *error = fix_error_create(FIX_ERROR_WRONG_FIELD_VALUE, "Tag '%d' value '%f' is not a finite number", tag, val);
+      return FIX_FAILED;
+   }
+   FIXField* field = fix_msg_set_field(msg, grp, fdescr, (unsigned char*)buff, res, error);
+   return field != NULL ? FIX_SUCCESS : FIX_FAILED;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+FIX_PARSER_API FIXErrCode fix_msg_set_decimal(FIXMsg* msg, FIXGroup* grp, FIXTagNum tag, int64_t mantissa, int32_t exponent,
+      FIXError** error)
+{
+   if (!msg)
+   {
+      return FIX_FAILED;
+   }
+   FIXFieldDescr const* fdescr = fix_protocol_get_descr(msg, grp, tag, error);
+   if (!fdescr)
+   {
+      return FIX_FAILED;
+   }
+   if (!IS_FLOAT_TYPE(fdescr->type->valueType))
+   {
+      *error = fix_error_create(FIX_ERROR_FIELD_HAS_WRONG_TYPE, "Tag '%d' type is not compatrible with value '%lldE%d'",
+            tag, (long long)mantissa, exponent);
+      return FIX_FAILED;
+   }
+   char buff[FIX_DECTOA_BUFF_LEN];
+   int32_t res = fix_utils_dectoa(mantissa, exponent, buff, sizeof(buff));
+   if (!res)
+   {
+      *error = fix_error_create(FIX_ERROR_INVALID_ARGUMENT, "Exponent %d is out of range [-%d, %d]", exponent,
+            FIX_DEC_MAX_EXPONENT, FIX_DEC_MAX_EXPONENT);
+      return FIX_FAILED;
+   }
    FIXField* field = fix_msg_set_field(msg, grp, fdescr, (unsigned char*)buff, res, error);
    return field != NULL ? FIX_SUCCESS : FIX_FAILED;
 }
@@ -380,6 +511,33 @@ FIX_PARSER_API FIXErrCode fix_msg_get_double(FIXMsg* msg, FIXGroup* grp, FIXTagN
    return fix_utils_atod((char const*)field->data, field->size, 0, val, &cnt);
 }
 
+/*------------------------------------------------------------------------------------------------------------------------*/
+FIX_PARSER_API FIXErrCode fix_msg_get_decimal(FIXMsg* msg, FIXGroup* grp, FIXTagNum tag, int64_t* mantissa, int32_t* exponent,
+      FIXError** error)
+{
+   if(!msg)
+   {
+      return FIX_FAILED;
+   }
+   FIXField* field = fix_field_get(msg, grp, tag);
+   if (!field)
+   {
+      return FIX_NO_FIELD;
+   }
+   if (field->descr->category != FIXFieldCategory_Value || !IS_FLOAT_TYPE(field->descr->type->valueType))
+   {
+      *error = fix_error_create(FIX_ERROR_FIELD_HAS_WRONG_TYPE, "Field %d is not a float value", tag);
+      return FIX_FAILED;
+   }
+   int32_t cnt;
+   if (FIX_SUCCESS != fix_utils_atodec((char const*)field->data, field->size, 0, mantissa, exponent, &cnt))
+   {
+      *error = fix_error_create(FIX_ERROR_WRONG_FIELD_VALUE, "Field %d value is not a decimal or too long", tag);
+      return FIX_FAILED;
+   }
+   return FIX_SUCCESS;
+}
+
 /*------------------------------------------------------------------------------------------------------------------------*/
 FIX_PARSER_API FIXErrCode fix_msg_get_char(FIXMsg* msg, FIXGroup* grp, FIXTagNum tag, char* val, FIXError** error)
 {
@@ -468,51 +626,72 @@ FIX_PARSER_API FIXErrCode fix_msg_to_str(FIXMsg* msg, char delimiter, char* buff
    {
       return FIX_ERROR_NO_MORE_SPACE;
    }
+   return fix_msg_fields_to_str(msg, delimiter, buff, buff + buffLen, NULL, error);
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+FIXErrCode fix_msg_fields_to_str(FIXMsg* msg, char delimiter, char* buff, char const* end, uint32_t* offsets,
+      FIXError** error)
+{
    FIXMsgDescr const* descr = msg->descr;
-   int32_t crc = 0;
+   int32_t const checkRequired = msg->parser->flags & PARSER_FLAG_CHECK_REQUIRED;
+   int32_t const checkValue = msg->parser->flags & PARSER_FLAG_CHECK_VALUE;
+   char const* const begin = buff;
    for(uint32_t i = 0; i < descr->field_count; ++i)
    {
-      char* prev = buff;
-      FIXFieldDescr* fdescr = &descr->fields[i];
-      FIXField* field = fix_field_get(msg, NULL, fdescr->type->tag);
+      FIXFieldDescr const* fdescr = &descr->fields[i];
       FIXErrCode res = FIX_SUCCESS;
-      if (fdescr->type->tag == FIXFieldTag_BodyLength)
+      if (offsets)
       {
-         res = int32_to_str(fdescr->type->tag, msg->body_len, delimiter, 0, 0, &buff, &buffLen, error);
+         offsets[i] = UINT32_MAX;
       }
-      else if(fdescr->type->tag == FIXFieldTag_CheckSum)
+      if (fdescr->emit == FIELD_EMIT_BODY_LENGTH)
       {
-         res = int32_to_str(fdescr->type->tag, crc % 256, delimiter, 3, '0', &buff, &buffLen, error);
-      }
-      else if ((msg->parser->flags & PARSER_FLAG_CHECK_REQUIRED) && !field && (fdescr->flags & FIELD_FLAG_REQUIRED))
-      {
-         *error = fix_error_create(FIX_ERROR_FIELD_NOT_FOUND, "Tag '%d' is required", fdescr->type->tag);
-         return FIX_FAILED;
+         char val[16];
+         int32_t const len = fix_utils_i64toa(msg->body_len, val, sizeof(val), 0);
+         res = fix_field_to_str(fdescr, val, len, delimiter, &buff, end, error);
       }
-      else if (field && field->descr->category == FIXFieldCategory_Group)
+      else if (fdescr->emit == FIELD_EMIT_CHECKSUM)
       {
-         res = fix_groups_to_string(msg, field, fdescr, delimiter, &buff, &buffLen, error);
+         char val[3];
+         fix_utils_i64toa(fix_utils_checksum(begin, buff - begin), val, sizeof(val), '0');
+         res = fix_field_to_str(fdescr, val, sizeof(val), delimiter, &buff, end, error);
       }
-      else if(field)
+      else
       {
-         if (msg->parser->flags & PARSER_FLAG_CHECK_VALUE)
+         FIXField const* field = fix_field_get_by_descr(msg, NULL, fdescr);
+         if (!field)
          {
-            if (!fix_protocol_check_field_value(fdescr, field->data, field->size))
+            if (checkRequired && (fdescr->flags & FIELD_FLAG_REQUIRED))
+            {
+               *error = fix_error_create(FIX_ERROR_FIELD_NOT_FOUND, "Tag '%d' is required", fdescr->type->tag);
+               return FIX_FAILED;
+            }
+            continue;
+         }
+         if (fdescr->emit == FIELD_EMIT_GROUP)
+         {
+            res = fix_groups_to_string(msg, field, fdescr, delimiter, &buff, end, error);
+         }
+         else
+         {
+            if (checkValue && !fix_protocol_check_field_value(fdescr, field->data, field->size))
             {
                *error = fix_error_create(FIX_ERROR_WRONG_FIELD_VALUE, "Wrong field '%s' value.", fdescr->type->name);
                return FIX_FAILED;
             }
+            if (offsets)
+            {
+               offsets[i] = buff - begin + fdescr->prefix_len;
+            }
+            res = fix_field_to_str(fdescr, field->data, field->size, delimiter, &buff, end, error);
          }
-         res = field_to_str(field, delimiter, &buff, &buffLen, error);
       }
       if (res == FIX_FAILED)
       {
          return FIX_FAILED;
       }
-      for(;(field || fdescr->type->tag == FIXFieldTag_BodyLength) && prev != buff; ++prev)
-      {
-         crc += *prev;
-      }
    }
    return FIX_SUCCESS;
 }
+
@@ -8,27 +8,97 @@
 #include "fix_parser_priv.h"
 #include "fix_utils.h"
 
+#include <assert.h>
 #include <string.h>
 
+#define BLOCK_SIZE(ptr) (*(uint32_t const*)((char const*)(ptr) - sizeof(uint32_t)))
+#define BLOCK_ALIGN 8 ///< blocks hold pointers and bitmap words, page data is 8-byte aligned
+/// offset of size header of first block at or after offset, header is placed right before aligned block
+#define BLOCK_HEADER(offset) ((((offset) + sizeof(uint32_t) + BLOCK_ALIGN - 1) & ~(BLOCK_ALIGN - 1)) - sizeof(uint32_t))
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+/* PRIVATES                                                                                                              */
+/*-----------------------------------------------------------------------------------------------------------------------*/
+static uint32_t fix_msg_block_class(uint32_t size)
+{
+   uint32_t const cls = LOG2_32(size) - MSG_FREE_CLASS_MIN;
+   return cls < MSG_FREE_CLASS_CNT ? cls : MSG_FREE_CLASS_CNT - 1;
+}
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+static void* fix_msg_take_block(FIXMsg* msg, uint32_t size)
+{
+   uint32_t cls = 0;
+   if (size > (1u << MSG_FREE_CLASS_MIN))
+   {
+      // class of block of the same size holds blocks of [2^n, 2^(n+1)), so only its head is checked,
+      // it fits, if blocks of this size are released and allocated in turn
+      cls = fix_msg_block_class(size);
+      if (!(msg->free_mask & (1u << cls)) || BLOCK_SIZE(msg->free_blocks[cls]) < size)
+      {
+         cls = fix_msg_block_class(size - 1) + 1; // the smallest class, which guarantees size
+      }
+   }
+   uint32_t const classes = cls < MSG_FREE_CLASS_CNT ? msg->free_mask >> cls << cls : 0;
+   if (!classes)
+   {
+      return NULL;
+   }
+   cls = CTZ64(classes);
+   void* ptr = msg->free_blocks[cls];
+   if (BLOCK_SIZE(ptr) < size) // last class is unbounded
+   {
+      return NULL;
+   }
+   msg->free_blocks[cls] = *(void**)ptr;
+   if (!msg->free_blocks[cls])
+   {
+      msg->free_mask &= ~(1u << cls);
+   }
+   return ptr;
+}
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+/* PUBLICS                                                                                                               */
 /*-----------------------------------------------------------------------------------------------------------------------*/
 void* fix_msg_alloc(FIXMsg* msg, uint32_t size, FIXError** error)
 {
+   if (UNLIKE(msg->free_mask))
+   {
+      void* ptr = fix_msg_take_block(msg, size);
+      if (ptr)
+      {
+         return ptr;
+      }
+   }
    FIXPage* curr_page = msg->curr_page;
 
-   if (curr_page->offset + sizeof(uint32_t) + size <= curr_page->size)
+   uint32_t const header = BLOCK_HEADER(curr_page->offset);
+   if (header + sizeof(uint32_t) + size <= curr_page->size)
    {
-      uint32_t old_offset = curr_page->offset;
-      *(uint32_t*)(curr_page->data + curr_page->offset) = size;
-      curr_page->offset += (size + sizeof(uint32_t));
-      return curr_page->data + old_offset + sizeof(uint32_t);
+      *(uint32_t*)(curr_page->data + header) = size;
+      curr_page->offset = header + sizeof(uint32_t) + size;
+      return curr_page->data + header + sizeof(uint32_t);
    }
    else
    {
-      FIXPage* new_page = fix_parser_alloc_page(msg->parser, size + sizeof(uint32_t), error);
-      if (!new_page)
+      // pages after current one are kept by fix_msg_reset, look for suitable one before asking parser
+      FIXPage* prev_page = curr_page;
+      FIXPage* new_page = curr_page->next;
+      while(new_page && BLOCK_HEADER(new_page->offset) + sizeof(uint32_t) + size > new_page->size)
+      {
+         prev_page = new_page;
+         new_page = new_page->next;
+      }
+      if (new_page)
+      {
+         prev_page->next = new_page->next;
+      }
+      else if (!(new_page = fix_parser_alloc_chunk(msg->parser, BLOCK_HEADER(0) + sizeof(uint32_t) + size, curr_page->size * 2, error)))
       {
          return NULL;
       }
+      new_page->next = curr_page->next;
       curr_page->next = new_page;
       msg->curr_page = new_page;
       return fix_msg_alloc(msg, size, error);
@@ -38,14 +108,33 @@ void* fix_msg_alloc(FIXMsg* msg, uint32_t size, FIXError** error)
 /*------------------------------------------------------------------------------------------------------------------------*/
 void* fix_msg_realloc(FIXMsg* msg, void* ptr, uint32_t size, FIXError** error)
 {
-   if (*(uint32_t*)((char const*)ptr - sizeof(uint32_t)) >= size)
+   uint32_t const old_size = BLOCK_SIZE(ptr);
+   if (old_size >= size)
    {
       return ptr;
    }
-   else
+   void* new_ptr = fix_msg_alloc(msg, size, error);
+   if (new_ptr)
    {
-      return fix_msg_alloc(msg, size, error);
+      memcpy(new_ptr, ptr, old_size);
+      fix_msg_free_block(msg, ptr);
+   }
+   return new_ptr;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+void fix_msg_free_block(FIXMsg* msg, void* ptr)
+{
+   uint32_t const size = BLOCK_SIZE(ptr);
+   if (size < (1u << MSG_FREE_CLASS_MIN)) // too small to hold link
+   {
+      return;
    }
+   uint32_t const cls = fix_msg_block_class(size);
+   assert(!((uintptr_t)ptr & (BLOCK_ALIGN - 1))); // link is stored in block itself
+   *(void**)ptr = msg->free_blocks[cls];
+   msg->free_blocks[cls] = ptr;
+   msg->free_mask |= 1u << cls;
 }
 
 /*------------------------------------------------------------------------------------------------------------------------*/
@@ -62,14 +151,29 @@ FIXField* fix_msg_set_field(FIXMsg* msg, FIXGroup* grp, FIXFieldDescr const* fde
 }
 
 /*------------------------------------------------------------------------------------------------------------------------*/
-FIXGroup* fix_msg_alloc_group(FIXMsg* msg, FIXError** error)
+FIXGroup* fix_msg_alloc_group(FIXMsg* msg, FIXFieldDescr const* parent_fdescr, FIXError** error)
 {
-   FIXGroup* grp = fix_parser_alloc_group(msg->parser, error);
+   FIXGroup* grp = msg->free_groups;
    if (grp)
    {
-      grp->next = msg->used_groups;
-      msg->used_groups = grp;
+      msg->free_groups = grp->next;
    }
+   else if (!(grp = fix_parser_alloc_group(msg->parser, error)))
+   {
+      return NULL;
+   }
+   grp->next = msg->used_groups;
+   msg->used_groups = grp;
+   grp->parent_fdescr = parent_fdescr;
+   grp->field_count = parent_fdescr ? parent_fdescr->group_count : msg->descr->field_count;
+   uint32_t const words = GROUP_USED_WORDS(grp->field_count);
+   grp->fields = (FIXField**)fix_msg_alloc(msg, sizeof(FIXField*) * grp->field_count + sizeof(uint64_t) * words, error);
+   if (!grp->fields)
+   {
+      return NULL;
+   }
+   grp->used = (uint64_t*)(grp->fields + grp->field_count);
+   memset(grp->used, 0, sizeof(uint64_t) * words); // slots stay dirty, they are valid only if marked in bitmap
    return grp;
 }
 
@@ -116,111 +220,67 @@ FIXField* fix_msg_get_field(FIXMsg* msg, FIXGroup* grp, FIXTagNum tag)
 }
 
 /*------------------------------------------------------------------------------------------------------------------------*/
-FIXErrCode int32_to_str(FIXTagNum tag, int32_t val, char delimiter, uint32_t width, char padSym, char** buff, uint32_t* buffLen, FIXError** error)
+FIXErrCode fix_field_to_str(FIXFieldDescr const* fdescr, void const* data, uint32_t size, char delimiter,
+      char** buff, char const* end, FIXError** error)
 {
-   if (UNLIKE(*buffLen == 0))
-   {
-      *error = fix_error_create(FIX_ERROR_NO_MORE_SPACE, "Not enough buffer space.");
-      return FIX_FAILED;
-   }
-   int32_t res = fix_utils_i64toa(tag, *buff, *buffLen, 0);
-   *buff += res;
-   *buffLen -= res;
-   if (UNLIKE(*buffLen == 0))
-   {
-      *error = fix_error_create(FIX_ERROR_NO_MORE_SPACE, "Not enough buffer space.");
-      return FIX_FAILED;
-   }
-   *(*buff) = '=';
-   *buff += 1;
-   *buffLen -= 1;
-   if (UNLIKE(*buffLen == 0))
-   {
-      *error = fix_error_create(FIX_ERROR_NO_MORE_SPACE, "Not enough buffer space.");
-      return FIX_FAILED;
-   }
-   res = fix_utils_i64toa(val, *buff, (width == 0) ? *buffLen : width, padSym);
-   *buff += res;
-   *buffLen -= res;
-   if (UNLIKE(*buffLen == 0))
+   if (UNLIKE((uint32_t)(end - *buff) < fdescr->prefix_len + size + 1))
    {
       *error = fix_error_create(FIX_ERROR_NO_MORE_SPACE, "Not enough buffer space.");
       return FIX_FAILED;
    }
-   *(*buff) = delimiter;
-   *buff += 1;
-   *buffLen -= 1;
+   char* p = *buff;
+   memcpy(p, fdescr->prefix, fdescr->prefix_len);
+   p += fdescr->prefix_len;
+   memcpy(p, data, size);
+   p += size;
+   *p = delimiter;
+   *buff = p + 1;
    return FIX_SUCCESS;
 }
 
 /*------------------------------------------------------------------------------------------------------------------------*/
-FIXErrCode field_to_str(FIXField const* field, char delimiter, char** buff, uint32_t* buffLen, FIXError** error)
+FIXErrCode fix_groups_to_string(FIXMsg* msg, FIXField const* field, FIXFieldDescr const* fdescr, char delimiter,
+      char** buff, char const* end, FIXError** error)
 {
-   if (UNLIKE(*buffLen == 0))
-   {
-      *error = fix_error_create(FIX_ERROR_NO_MORE_SPACE, "Not enough buffer space.");
-      return FIX_FAILED;
-   }
-   int32_t res = fix_utils_i64toa(field->descr->type->tag, *buff, *buffLen, 0);
-   *buff += res;
-   *buffLen -= res;
-   if (UNLIKE(*buffLen == 0))
-   {
-      *error = fix_error_create(FIX_ERROR_NO_MORE_SPACE, "Not enough buffer space.");
-      return FIX_FAILED;
-   }
-   *(*buff) = '=';
-   *buff += 1;
-   *buffLen -= 1;
-   if (UNLIKE(*buffLen == 0))
+   char count[16];
+   int32_t const countLen = fix_utils_i64toa(field->size, count, sizeof(count), 0);
+   if (fix_field_to_str(fdescr, count, countLen, delimiter, buff, end, error) == FIX_FAILED)
    {
-      *error = fix_error_create(FIX_ERROR_NO_MORE_SPACE, "Not enough buffer space.");
-      return FIX_FAILED;
-   }
-   uint32_t const len = (*buffLen > field->size) ? field->size : *buffLen;
-   strncpy(*buff, (char const*)field->data, len);
-   *buff += len;
-   *buffLen -= len;
-   if (UNLIKE(*buffLen == 0))
-   {
-      *error = fix_error_create(FIX_ERROR_NO_MORE_SPACE, "Not enough buffer space.");
       return FIX_FAILED;
    }
-   *(*buff) = delimiter;
-   *buff += 1;
-   *buffLen -= 1;
-   return FIX_SUCCESS;
-}
-
-/*------------------------------------------------------------------------------------------------------------------------*/
-FIXErrCode fix_groups_to_string(FIXMsg* msg, FIXField const* field, FIXFieldDescr const* fdescr, char delimiter,
-      char** buff, uint32_t* buffLen, FIXError** error)
-{
-   FIXErrCode res = int32_to_str(field->descr->type->tag, field->size, delimiter, 0, 0, buff, buffLen, error);
-   for(uint32_t i = 0; i < field->size && res != FIX_FAILED; ++i)
+   int32_t const checkRequired = msg->parser->flags & PARSER_FLAG_CHECK_REQUIRED;
+   for(uint32_t i = 0; i < field->size; ++i)
    {
       FIXGroup* group = ((FIXGroups*)field->data)->group[i];
-      for(uint32_t i = 0; i < fdescr->group_count && res == FIX_SUCCESS; ++i)
+      for(uint32_t j = 0; j < fdescr->group_count; ++j)
       {
-         FIXFieldDescr* child_fdescr = &fdescr->group[i];
-         FIXField* child_field = fix_field_get(msg, group, child_fdescr->type->tag);
-         if ((msg->parser->flags & PARSER_FLAG_CHECK_REQUIRED) && !child_field && (child_fdescr->flags & FIELD_FLAG_REQUIRED))
+         FIXFieldDescr const* child_fdescr = &fdescr->group[j];
+         FIXField* child_field = fix_field_get_by_descr(msg, group, child_fdescr);
+         FIXErrCode res = FIX_SUCCESS;
+         if (!child_field)
          {
-            *error = fix_error_create(FIX_ERROR_FIELD_NOT_FOUND, "Field '%d' is required", child_fdescr->type->tag);
-            return FIX_FAILED;
+            if (checkRequired && (child_fdescr->flags & FIELD_FLAG_REQUIRED))
+            {
+               *error = fix_error_create(FIX_ERROR_FIELD_NOT_FOUND, "Field '%d' is required", child_fdescr->type->tag);
+               return FIX_FAILED;
+            }
+            else if (j == 0)
+            {
+               *error = fix_error_create(FIX_ERROR_FIELD_NOT_FOUND, "Field '%d' must be first field in group", child_fdescr->type->tag);
+               return FIX_FAILED;
+            }
          }
-         else if (!child_field && i == 0)
+         else if (child_fdescr->emit == FIELD_EMIT_GROUP)
          {
-            *error = fix_error_create(FIX_ERROR_FIELD_NOT_FOUND, "Field '%d' must be first field in group", child_fdescr->type->tag);
-            return FIX_FAILED;
+            res = fix_groups_to_string(msg, child_field, child_fdescr, delimiter, buff, end, error);
          }
-         else if (child_field && child_field->descr->category == FIXFieldCategory_Group)
+         else
          {
-            res = fix_groups_to_string(msg, child_field, child_fdescr, delimiter, buff, buffLen, error);
+            res = fix_field_to_str(child_fdescr, child_field->data, child_field->size, delimiter, buff, end, error);
          }
-         else if(child_field)
+         if (res == FIX_FAILED)
          {
-            res = field_to_str(child_field, delimiter, buff, buffLen, error);
+            return FIX_FAILED;
          }
       }
    }
@@ -21,6 +21,10 @@ extern "C"
 {
 #endif
 
+#define MSG_FLAG_VIEW 0x01 ///< message parsed by fix_parser_str_to_view, parsed values reference input buffer
+#define MSG_FREE_CLASS_MIN 3   ///< first size class holds blocks of 8..15 bytes, smaller blocks are not reclaimed
+#define MSG_FREE_CLASS_CNT 13  ///< count of size classes, last one holds blocks of 32 KB and more
+
 /**
  * FIX message
  */
@@ -32,11 +36,34 @@ struct FIXMsg_
    FIXPage* pages;            ///< allocated pages with FIX field data
    FIXPage* curr_page;        ///< current memory page
    FIXGroup* used_groups;     ///< used groups by this message
+   FIXGroup* free_groups;     ///< groups kept by fix_msg_reset for reuse
    uint32_t body_len;         ///< entire body len, if message converted to FIX data
+   uint32_t flags;            ///< MSG_FLAG_VIEW
+   void* free_blocks[MSG_FREE_CLASS_CNT]; ///< abandoned blocks of pages by size class (power of two), reused by fix_msg_alloc
+   uint32_t free_mask;        ///< bit per non-empty class of free_blocks
+   struct FIXMsg_* next;      ///< next message in pool of unused messages. If this message is used next == NULL
 };
 
 /**
- * allocate data for this message
+ * create new message with already known description
+ * @param[in] parser - message holder
+ * @param[in] msg_descr - message description
+ * @param[out] error - error description
+ * @return new message, NULL - see error description
+ */
+FIXMsg* fix_msg_create_by_descr(FIXParser* parser, FIXMsgDescr const* msg_descr, FIXError** error);
+
+/**
+ * clear message in place and assign new description to it. Pages and groups are kept for reuse
+ * @param[in] msg - message being reset
+ * @param[in] msg_descr - new message description
+ * @param[out] error - error description
+ * @return FIX_SUCCESS - ok, FIX_FAILED - see error description
+ */
+FIXErrCode fix_msg_reset_by_descr(FIXMsg* msg, FIXMsgDescr const* msg_descr, FIXError** error);
+
+/**
+ * allocate data for this message. Blocks released by fix_msg_free_block are reused first
  * @param[in] msg - pointer to message
  * @param[in] size - size of data being allocated
  * @param[out] error - error description
@@ -44,11 +71,19 @@ struct FIXMsg_
  */
 void* fix_msg_alloc(FIXMsg* msg, uint32_t size, FIXError** error);
 
+/**
+ * return block allocated by fix_msg_alloc to message free list, so it can be reused by next allocations
+ * @param[in] msg - msg with allocated space
+ * @param[in] ptr - pointer to data previously allocated. Block content is destroyed
+ */
+void fix_msg_free_block(FIXMsg* msg, void* ptr);
+
 /**
  * realloc previous allocated space
  * @param[in] msg - msg with allocated space
  * @param[in] ptr - pointer to data previously allocated
- * @param[in] size - new size of allocated space. If new size greater, new space will be allocated, else no new space allocated
+ * @param[in] size - new size of allocated space. If new size greater, new space will be allocated and old content is
+ * copied into it, old space is released by fix_msg_free_block. Else no new space allocated
  * @param[out] error - error description
  * @return pointer to reallocated space, NULL - see error description
  */
@@ -75,12 +110,13 @@ FIXField* fix_msg_get_field(FIXMsg* msg, FIXGroup* grp, FIXTagNum tag);
 FIXField* fix_msg_set_field(FIXMsg* msg, FIXGroup* grp, FIXFieldDescr const* fdescr, unsigned char const* data, uint32_t len, FIXError** error);
 
 /**
- * create new FIX group
+ * create new FIX group. Group slots are allocated from message pages
  * @param[in] msg - FIX message
+ * @param[in] parent_fdescr - description of FIX field, which defines group. NULL for root group of message
  * @param[out] error - error description
  * @return new FIX group
  */
-FIXGroup* fix_msg_alloc_group(FIXMsg* msg, FIXError** error);
+FIXGroup* fix_msg_alloc_group(FIXMsg* msg, FIXFieldDescr const* parent_fdescr, FIXError** error);
 
 /**
  * destroy FIX group
@@ -90,42 +126,47 @@ FIXGroup* fix_msg_alloc_group(FIXMsg* msg, FIXError** error);
 void fix_msg_free_group(FIXMsg* msg, FIXGroup* grp);
 
 /**
- * converts FIX group to string
- * @param[in] msg - FIX message with converted FIX group
- * @param[in] field - FIX field with group data
- * @param[in] fdescr - FIX field description
+ * serialize message fields by serialization plan of message description. Buffer must be large enough, see fix_msg_to_str
+ * @param[in] msg - FIX message
  * @param[in] delimiter - FIX field SOH
- * @param[out] buff - space with converted data
- * @param[out] buffLen - size of converted data
+ * @param[out] buff - space for converted data
+ * @param[in] end - end of space for converted data
+ * @param[out] offsets - if not NULL, offsets[i] is set to offset of value of msg->descr->fields[i] from buff.
+ * UINT32_MAX - field is absent or it is not a plain value (group, BodyLength, CheckSum). Array of
+ * msg->descr->field_count items is required
  * @param[out] error - error description
  * @return FIX_SUCCESS - ok, FIX_FAILED - see error description
  */
-FIXErrCode fix_groups_to_string(FIXMsg* msg, FIXField const* field, FIXFieldDescr const* fdescr, char delimiter, char** buff, uint32_t* buffLen, FIXError** error);
+FIXErrCode fix_msg_fields_to_str(FIXMsg* msg, char delimiter, char* buff, char const* end, uint32_t* offsets,
+      FIXError** error);
 
 /**
- * convert numeric value to string
- * @param[in] tag - FIX field tag value
- * @param[in] val - converted value
- * @param[in] delimiter - FIX field delimiter
- * @param[in] width - value width
- * @param[in] padSym - char for padding value width. E.g. tag = 35, width = 5, padSym = '0' and value is 10, so converted data is '35=00010'
- * @param[out] buff - buffer with converted data
- * @param[out] buffLen - size of converted data
+ * converts FIX group to string by serialization plan of group fields
+ * @param[in] msg - FIX message with converted FIX group
+ * @param[in] field - FIX field with group data
+ * @param[in] fdescr - FIX field description
+ * @param[in] delimiter - FIX field SOH
+ * @param[in,out] buff - space for converted data, on return - position after converted data
+ * @param[in] end - end of space for converted data
  * @param[out] error - error description
  * @return FIX_SUCCESS - ok, FIX_FAILED - see error description
  */
-FIXErrCode int32_to_str(FIXTagNum tag, int32_t val, char delimiter, uint32_t width, char padSym, char** buff, uint32_t* buffLen, FIXError** error);
+FIXErrCode fix_groups_to_string(FIXMsg* msg, FIXField const* field, FIXFieldDescr const* fdescr, char delimiter,
+      char** buff, char const* end, FIXError** error);
 
 /**
- * convert FIX field to string
- * @param[in] field - FIX field being converted
+ * write FIX field as pre-rendered "tag=" prefix of description, value and delimiter
+ * @param[in] fdescr - FIX field description
+ * @param[in] data - field value
+ * @param[in] size - length of field value
  * @param[in] delimiter - FIX field SOH
- * @param[out] buff - buffer with converted data
- * @param[out] buffLen - size of converted data
+ * @param[in,out] buff - space for converted data, on return - position after converted data
+ * @param[in] end - end of space for converted data
  * @param[out] error - error description
  * @return FIX_SUCCESS - ok, FIX_FAILED - see error description
  */
-FIXErrCode field_to_str(FIXField const* field, char delimiter, char** buff, uint32_t* buffLen, FIXError** error);
+FIXErrCode fix_field_to_str(FIXFieldDescr const* fdescr, void const* data, uint32_t size, char delimiter,
+      char** buff, char const* end, FIXError** error);
 
 #ifdef __cplusplus
 }
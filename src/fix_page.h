@@ -17,12 +17,26 @@
  */
 typedef struct FIXPage_
 {
-   uint32_t size;          ///< size of page
-   uint32_t offset;        ///< offset of free space
-   struct FIXPage_* next;  ///< next page
-   char data[1];           ///< start of data
+   uint32_t size;                   ///< size of page
+   uint32_t offset;                 ///< offset of free space
+   struct FIXPage_* next;           ///< next page
+   struct FIXArenaBlock_* block;    ///< arena block, which page is carved from. NULL - page is allocated separately
+   char data[1];                    ///< start of data
 } FIXPage;
 
+/**
+ * block of memory, which small message pages are bump-allocated from. Block is reused, when all its pages are freed
+ */
+typedef struct FIXArenaBlock_
+{
+   struct FIXArenaBlock_* next;     ///< next block in list of free blocks
+   uint32_t size;                   ///< size of data
+   uint32_t offset;                 ///< offset of free space
+   uint32_t live;                   ///< count of pages carved from block and not freed yet
+   uint32_t reserved;               ///< keeps data 8-byte aligned
+   char data[1];                    ///< start of data
+} FIXArenaBlock;
+
 #pragma pack(pop)
 
 #endif /* FIX_PARSER_FIX_PAGE_H */
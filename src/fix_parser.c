@@ -19,12 +19,64 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
+#include <errno.h>
 
 #define CRC_FIELD_LEN 7
+#define SLAB_ALIGN 64 ///< slab objects are aligned to cache line
+#define SLAB_STRIDE(size) (((size) + SLAB_ALIGN - 1) / SLAB_ALIGN * SLAB_ALIGN)
+
+/**
+ * state shared by consecutive fix_parser_parse_msg calls of one parse request
+ */
+typedef struct FIXParseCtx_
+{
+   uint32_t msgFlags;               ///< flags of parsed messages (MSG_FLAG_VIEW)
+   uint32_t verLen;                 ///< length of parser transport version
+   FIXMsgDescr const* descr;        ///< description of last parsed message
+   uint32_t typeLen;                ///< length of last parsed message type
+   uint8_t const* mask;             ///< projection mask of last parsed message type, NULL - all fields are stored
+} FIXParseCtx;
+
+static void fix_parser_init_ctx(FIXParser* parser, uint32_t msgFlags, FIXParseCtx* ctx);
+static FIXErrCode fix_parser_create_pools(FIXParser* parser, FIXError** error);
+static int32_t fix_parser_in_slab(FIXParser const* parser, void const* ptr);
+static FIXMsg* fix_parser_parse_msg(FIXParser* parser, FIXParseCtx* ctx, FIXMsg* target, char const* data, uint32_t len,
+      char delimiter, char const** stop, FIXError** error);
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+FIX_PARSER_API FIXProtocolDescr const* fix_protocol_create(char const* protFile, FIXError** error)
+{
+   return fix_protocol_descr_create(protFile, NULL, error);
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+FIX_PARSER_API void fix_protocol_free(FIXProtocolDescr const* prot)
+{
+   fix_protocol_descr_free(prot);
+}
 
 /*------------------------------------------------------------------------------------------------------------------------*/
 FIX_PARSER_API FIXParser* fix_parser_create(char const* protFile, FIXParserAttrs const* attrs, int32_t flags, FIXError** error)
 {
+   FIXProtocolDescr const* prot = fix_protocol_descr_create(protFile, attrs ? &attrs->allocator : NULL, error);
+   if (!prot)
+   {
+      return NULL;
+   }
+   FIXParser* parser = fix_parser_create_with_protocol(prot, attrs, flags, error);
+   fix_protocol_descr_free(prot);
+   return parser;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+FIX_PARSER_API FIXParser* fix_parser_create_with_protocol(FIXProtocolDescr const* prot, FIXParserAttrs const* attrs,
+      int32_t flags, FIXError** error)
+{
+   if (!prot)
+   {
+      *error = fix_error_create(FIX_ERROR_INVALID_ARGUMENT, "Protocol description is NULL.");
+      return NULL;
+   }
    FIXParserAttrs myattrs = {};
    if (attrs)
    {
@@ -35,34 +87,30 @@ FIX_PARSER_API FIXParser* fix_parser_create(char const* protFile, FIXParserAttrs
    {
       goto failed;
    }
-   parser = (FIXParser*)calloc(1, sizeof(FIXParser));
-   memcpy(&parser->attrs, &myattrs, sizeof(parser->attrs));
-   parser->flags = flags;
-   parser->protocol = fix_protocol_descr_create(protFile, error);
-   if (!parser->protocol)
+   parser = (FIXParser*)fix_utils_alloc(&myattrs.allocator, sizeof(FIXParser));
+   if (!parser)
    {
+      *error = fix_error_create(FIX_ERROR_MALLOC, "Unable to allocate parser.");
       goto failed;
    }
-   for(uint32_t i = 0; i < parser->attrs.numPages; ++i)
+   memcpy(&parser->attrs, &myattrs, sizeof(parser->attrs));
+   parser->flags = flags;
+   parser->protocol = fix_protocol_descr_ref(prot);
+   parser->msg_stats = (FIXMsgStats*)fix_utils_alloc(&myattrs.allocator, (prot->msg_count ? prot->msg_count : 1) * sizeof(FIXMsgStats));
+   if (!parser->msg_stats)
    {
-      FIXPage* page = (FIXPage*)calloc(1, sizeof(FIXPage) + parser->attrs.pageSize - 1);
-      assert(page);
-      page->size = parser->attrs.pageSize;
-      page->next = parser->page;
-      parser->page = page;
+      *error = fix_error_create(FIX_ERROR_MALLOC, "Unable to allocate message statistics.");
+      goto failed;
    }
-   for(uint32_t i = 0; i < parser->attrs.numGroups; ++i)
+   if (fix_parser_create_pools(parser, error) == FIX_FAILED)
    {
-      FIXGroup* group = (FIXGroup*)calloc(1, sizeof(FIXGroup));
-      assert(group);
-      group->next = parser->group;
-      parser->group = group;
+      goto failed;
    }
    goto ok;
 failed:
    if (parser)
    {
-      free(parser);
+      fix_parser_free(parser);
       parser = NULL;
    }
 ok:
@@ -74,6 +122,7 @@ FIX_PARSER_API void fix_parser_free(FIXParser* parser)
 {
    if (parser)
    {
+      FIXAllocator const* allocator = &parser->attrs.allocator;
       if (parser->protocol)
       {
          fix_protocol_descr_free(parser->protocol);
@@ -82,20 +131,65 @@ FIX_PARSER_API void fix_parser_free(FIXParser* parser)
       while(page)
       {
          FIXPage* next = page->next;
-         free(page);
+         if (!fix_parser_in_slab(parser, page))
+         {
+            fix_utils_free(allocator, page);
+         }
          page = next;
       }
       FIXGroup* group = parser->group;
       while(group)
       {
          FIXGroup* next = group->next;
-         free(group);
+         if (!fix_parser_in_slab(parser, group))
+         {
+            fix_utils_free(allocator, group);
+         }
          group = next;
       }
-      free(parser);
+      FIXMsg* msg = parser->msg;
+      while(msg)
+      {
+         FIXMsg* next = msg->next;
+         if (!fix_parser_in_slab(parser, msg))
+         {
+            fix_utils_free(allocator, msg);
+         }
+         msg = next;
+      }
+      fix_utils_slab_free(parser->slab, parser->slab_size);
+      fix_utils_free(allocator, parser->arena);
+      FIXArenaBlock* block = parser->free_blocks;
+      while(block)
+      {
+         FIXArenaBlock* next = block->next;
+         fix_utils_free(allocator, block);
+         block = next;
+      }
+      fix_utils_free(allocator, parser->msg_stats);
+      FIXProjection* proj = parser->projections;
+      while(proj)
+      {
+         FIXProjection* next = proj->next;
+         fix_utils_free(allocator, proj->mask);
+         fix_utils_free(allocator, proj);
+         proj = next;
+      }
+      FIXAllocator const parserAllocator = parser->attrs.allocator;
+      fix_utils_free(&parserAllocator, parser);
    }
 }
 
+/*------------------------------------------------------------------------------------------------------------------------*/
+FIX_PARSER_API FIXProtocolDescr const* fix_parser_get_protocol(FIXParser* parser)
+{
+   if (!parser)
+   {
+      return NULL;
+   }
+   return parser->protocol;
+}
+
 /*------------------------------------------------------------------------------------------------------------------------*/
 FIX_PARSER_API char const* fix_parser_get_protocol_ver(FIXParser* parser)
 {
@@ -106,6 +200,207 @@ FIX_PARSER_API char const* fix_parser_get_protocol_ver(FIXParser* parser)
    return parser->protocol->version;
 }
 
+/*------------------------------------------------------------------------------------------------------------------------*/
+FIX_PARSER_API FIXErrCode fix_parser_set_projection(FIXParser* parser, char const* msgType, FIXTagNum const* tags,
+      uint32_t tagCount, FIXError** error)
+{
+   if (!parser || !msgType || (!tags && tagCount))
+   {
+      return FIX_FAILED;
+   }
+   FIXMsgDescr const* descr = fix_protocol_get_msg_descr(parser, msgType, error);
+   if (!descr)
+   {
+      return FIX_FAILED;
+   }
+   uint8_t* mask = (uint8_t*)fix_utils_alloc(&parser->attrs.allocator, descr->field_count ? descr->field_count : 1);
+   if (!mask)
+   {
+      *error = fix_error_create(FIX_ERROR_MALLOC, "Unable to allocate projection mask.");
+      return FIX_FAILED;
+   }
+   for(uint32_t i = 0; i < tagCount; ++i)
+   {
+      FIXFieldDescr const* fdescr = fix_protocol_get_field_descr(descr, tags[i]);
+      if (!fdescr)
+      {
+         *error = fix_error_create(FIX_ERROR_UNKNOWN_FIELD, "Field with tag %d not found in message '%s' description.",
+               tags[i], descr->name);
+         fix_utils_free(&parser->attrs.allocator, mask);
+         return FIX_FAILED;
+      }
+      mask[fdescr->ordinal] = 1;
+   }
+   for(uint32_t i = 0; i < descr->field_count; ++i)
+   {
+      if (descr->fields[i].dataLenField) // length is needed to skip or parse Data field
+      {
+         mask[descr->fields[i].dataLenField->ordinal] = 1;
+      }
+   }
+   FIXProjection* proj = parser->projections;
+   while(proj && proj->descr != descr)
+   {
+      proj = proj->next;
+   }
+   if (!proj)
+   {
+      proj = (FIXProjection*)fix_utils_alloc(&parser->attrs.allocator, sizeof(FIXProjection));
+      if (!proj)
+      {
+         *error = fix_error_create(FIX_ERROR_MALLOC, "Unable to allocate projection.");
+         fix_utils_free(&parser->attrs.allocator, mask);
+         return FIX_FAILED;
+      }
+      proj->descr = descr;
+      proj->next = parser->projections;
+      parser->projections = proj;
+   }
+   fix_utils_free(&parser->attrs.allocator, proj->mask);
+   proj->mask = mask;
+   return FIX_SUCCESS;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+FIX_PARSER_API FIXErrCode fix_parser_reset_projection(FIXParser* parser, char const* msgType)
+{
+   if (!parser || !msgType)
+   {
+      return FIX_FAILED;
+   }
+   FIXProjection* proj = parser->projections;
+   FIXProjection* prev = NULL;
+   while(proj && strcmp(proj->descr->type, msgType))
+   {
+      prev = proj;
+      proj = proj->next;
+   }
+   if (!proj)
+   {
+      return FIX_FAILED;
+   }
+   if (prev)
+   {
+      prev->next = proj->next;
+   }
+   else
+   {
+      parser->projections = proj->next;
+   }
+   fix_utils_free(&parser->attrs.allocator, proj->mask);
+   fix_utils_free(&parser->attrs.allocator, proj);
+   return FIX_SUCCESS;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+FIX_PARSER_API FIXErrCode fix_parser_get_msg_stats(FIXParser* parser, char const* msgType, FIXMsgStats* stats,
+      FIXError** error)
+{
+   if (!parser || !msgType || !stats)
+   {
+      return FIX_FAILED;
+   }
+   FIXMsgDescr const* descr = fix_protocol_get_msg_descr(parser, msgType, error);
+   if (!descr)
+   {
+      return FIX_FAILED;
+   }
+   *stats = parser->msg_stats[descr->id];
+   return FIX_SUCCESS;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+FIX_PARSER_API FIXErrCode fix_parser_get_stats(FIXParser* parser, FIXParserStats* stats)
+{
+   if (!parser || !stats)
+   {
+      return FIX_FAILED;
+   }
+   *stats = parser->stats;
+   stats->pages.used = parser->used_pages;
+   stats->pages.free = 0;
+   for(FIXPage const* page = parser->page; page; page = page->next)
+   {
+      ++stats->pages.free;
+   }
+   stats->groups.used = parser->used_groups;
+   stats->groups.free = 0;
+   for(FIXGroup const* group = parser->group; group; group = group->next)
+   {
+      ++stats->groups.free;
+   }
+   stats->msgs.used = parser->used_msgs;
+   stats->msgs.free = 0;
+   for(FIXMsg const* msg = parser->msg; msg; msg = msg->next)
+   {
+      ++stats->msgs.free;
+   }
+   stats->freeArenaBlocks = 0;
+   for(FIXArenaBlock const* block = parser->free_blocks; block; block = block->next)
+   {
+      ++stats->freeArenaBlocks;
+   }
+   return FIX_SUCCESS;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+FIX_PARSER_API FIXErrCode fix_parser_trim(FIXParser* parser, uint32_t numPages, uint32_t numGroups, uint32_t numMsgs)
+{
+   FIXParserStats stats;
+   if (fix_parser_get_stats(parser, &stats) == FIX_FAILED)
+   {
+      return FIX_FAILED;
+   }
+   // slab objects stay in pools, only heap ones are released
+   FIXPage** page = &parser->page;
+   while(*page && stats.pages.used + stats.pages.free > numPages)
+   {
+      if (fix_parser_in_slab(parser, *page))
+      {
+         page = &(*page)->next;
+         continue;
+      }
+      FIXPage* next = (*page)->next;
+      fix_utils_free(&parser->attrs.allocator, *page);
+      *page = next;
+      --stats.pages.free;
+   }
+   FIXGroup** group = &parser->group;
+   while(*group && stats.groups.used + stats.groups.free > numGroups)
+   {
+      if (fix_parser_in_slab(parser, *group))
+      {
+         group = &(*group)->next;
+         continue;
+      }
+      FIXGroup* next = (*group)->next;
+      fix_utils_free(&parser->attrs.allocator, *group);
+      *group = next;
+      --stats.groups.free;
+   }
+   FIXMsg** msg = &parser->msg;
+   while(*msg && stats.msgs.used + stats.msgs.free > numMsgs)
+   {
+      if (fix_parser_in_slab(parser, *msg))
+      {
+         msg = &(*msg)->next;
+         continue;
+      }
+      FIXMsg* next = (*msg)->next;
+      fix_utils_free(&parser->attrs.allocator, *msg);
+      *msg = next;
+      --stats.msgs.free;
+   }
+   while(parser->free_blocks)
+   {
+      FIXArenaBlock* next = parser->free_blocks->next;
+      fix_utils_free(&parser->attrs.allocator, parser->free_blocks);
+      parser->free_blocks = next;
+      --parser->stats.arenaBlocks;
+   }
+   return FIX_SUCCESS;
+}
+
 /*------------------------------------------------------------------------------------------------------------------------*/
 FIX_PARSER_API FIXErrCode fix_parser_get_header(char const* data, uint32_t len, char delimiter,
       char const** beginString, uint32_t* beginStringLen,
@@ -172,6 +467,44 @@ FIX_PARSER_API FIXErrCode fix_parser_get_header(char const* data, uint32_t len,
    return FIX_SUCCESS;
 }
 
+/*------------------------------------------------------------------------------------------------------------------------*/
+FIX_PARSER_API FIXErrCode fix_parser_peek(char const* data, uint32_t len, char delimiter, FIXTagNum const* tags,
+      FIXFieldSpan* spans, uint32_t tagCount, uint32_t maxFields, uint32_t* found, FIXError** error)
+{
+   if (!data || (tagCount && (!tags || !spans)) || !found)
+   {
+      return FIX_FAILED;
+   }
+   for(uint32_t i = 0; i < tagCount; ++i)
+   {
+      spans[i].data = NULL;
+      spans[i].len = 0;
+   }
+   *found = 0;
+   for(uint32_t fields = 0; len && *found < tagCount && (!maxFields || fields < maxFields); ++fields)
+   {
+      char const* dbegin = NULL;
+      char const* dend = NULL;
+      FIXTagNum tag = fix_parser_parse_mandatory_field(data, len, delimiter, &dbegin, &dend, error);
+      if (tag == FIX_FAILED)
+      {
+         return FIX_FAILED;
+      }
+      for(uint32_t i = 0; i < tagCount; ++i)
+      {
+         if (tags[i] == tag && !spans[i].data)
+         {
+            spans[i].data = dbegin;
+            spans[i].len = dend - dbegin;
+            ++(*found);
+         }
+      }
+      len -= (dend - data + 1);
+      data = dend + 1;
+   }
+   return FIX_SUCCESS;
+}
+
 /*------------------------------------------------------------------------------------------------------------------------*/
 FIX_PARSER_API FIXMsg* fix_parser_str_to_msg(FIXParser* parser, char const* data, uint32_t len, char delimiter,
       char const** stop, FIXError** error)
@@ -180,6 +513,162 @@ FIX_PARSER_API FIXMsg* fix_parser_str_to_msg(FIXParser* parser, char const* data
    {
       return NULL;
    }
+   FIXParseCtx ctx;
+   fix_parser_init_ctx(parser, 0, &ctx);
+   return fix_parser_parse_msg(parser, &ctx, NULL, data, len, delimiter, stop, error);
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+FIX_PARSER_API FIXMsg* fix_parser_str_to_view(FIXParser* parser, char const* data, uint32_t len, char delimiter,
+      char const** stop, FIXError** error)
+{
+   if (!parser || !data)
+   {
+      return NULL;
+   }
+   FIXParseCtx ctx;
+   fix_parser_init_ctx(parser, MSG_FLAG_VIEW, &ctx);
+   return fix_parser_parse_msg(parser, &ctx, NULL, data, len, delimiter, stop, error);
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+FIX_PARSER_API FIXErrCode fix_parser_str_to_msg_into(FIXParser* parser, FIXMsg* msg, char const* data, uint32_t len,
+      char delimiter, char const** stop, FIXError** error)
+{
+   if (!parser || !msg || !data)
+   {
+      return FIX_FAILED;
+   }
+   if (msg->parser != parser)
+   {
+      *error = fix_error_create(FIX_ERROR_INVALID_ARGUMENT, "Message is created by another parser.");
+      return FIX_FAILED;
+   }
+   FIXParseCtx ctx;
+   fix_parser_init_ctx(parser, 0, &ctx);
+   return fix_parser_parse_msg(parser, &ctx, msg, data, len, delimiter, stop, error) ? FIX_SUCCESS : FIX_FAILED;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+FIX_PARSER_API FIXErrCode fix_parser_str_to_msgs(FIXParser* parser, char const* data, uint32_t len, char delimiter,
+      FIXMsg** msgs, uint32_t maxMsgs, uint32_t* count, char const** stop, FIXError** error)
+{
+   if (!parser || !data || !msgs || !count || !stop)
+   {
+      return FIX_FAILED;
+   }
+   FIXParseCtx ctx;
+   fix_parser_init_ctx(parser, 0, &ctx);
+   char const* end = data + len;
+   *count = 0;
+   *stop = data;
+   while(*count < maxMsgs && *stop != end)
+   {
+      char const* msgEnd = NULL;
+      FIXMsg* msg = fix_parser_parse_msg(parser, &ctx, NULL, *stop, end - *stop, delimiter, &msgEnd, error);
+      if (!msg)
+      {
+         if (*error && fix_error_get_code(*error) == FIX_ERROR_NO_MORE_DATA) // incomplete tail, wait for more data
+         {
+            fix_error_free(*error);
+            *error = NULL;
+            break;
+         }
+         return FIX_FAILED;
+      }
+      msgs[(*count)++] = msg;
+      *stop = msgEnd + 1;
+   }
+   return FIX_SUCCESS;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+/* PRIVATES                                                                                                               */
+/*------------------------------------------------------------------------------------------------------------------------*/
+static void fix_parser_init_ctx(FIXParser* parser, uint32_t msgFlags, FIXParseCtx* ctx)
+{
+   ctx->msgFlags = msgFlags;
+   ctx->verLen = strlen(parser->protocol->transportVersion);
+   ctx->descr = NULL;
+   ctx->typeLen = 0;
+   ctx->mask = NULL;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+static FIXErrCode fix_parser_create_pools(FIXParser* parser, FIXError** error)
+{
+   FIXParserAttrs const* attrs = &parser->attrs;
+   uint64_t const pageStride = SLAB_STRIDE(sizeof(FIXPage) + attrs->pageSize - 1);
+   uint64_t const groupStride = SLAB_STRIDE(sizeof(FIXGroup));
+   uint64_t const msgStride = SLAB_STRIDE(sizeof(FIXMsg));
+   char* pages = NULL;
+   char* groups = NULL;
+   char* msgs = NULL;
+   if (attrs->poolFlags)
+   {
+      parser->slab_size = pageStride * attrs->numPages + groupStride * attrs->numGroups + msgStride * attrs->numMsgs;
+      parser->slab = (char*)fix_utils_slab_alloc(&parser->slab_size, attrs->poolFlags, attrs->numaNode);
+      if (!parser->slab)
+      {
+         *error = fix_error_create(FIX_ERROR_MALLOC, "Unable to allocate pool slab of %llu bytes: %s",
+               (unsigned long long)parser->slab_size, strerror(errno));
+         return FIX_FAILED;
+      }
+      pages = parser->slab;
+      groups = pages + pageStride * attrs->numPages;
+      msgs = groups + groupStride * attrs->numGroups;
+   }
+   // pools are filled from the end, so objects are taken in ascending address order
+   for(uint32_t i = attrs->numPages; i > 0; --i)
+   {
+      FIXPage* page = pages ? (FIXPage*)(pages + pageStride * (i - 1)) :
+         (FIXPage*)fix_utils_alloc(&attrs->allocator, sizeof(FIXPage) + attrs->pageSize - 1);
+      if (!page)
+      {
+         *error = fix_error_create(FIX_ERROR_MALLOC, "Unable to allocate page.");
+         return FIX_FAILED;
+      }
+      page->size = attrs->pageSize;
+      page->next = parser->page;
+      parser->page = page;
+   }
+   for(uint32_t i = attrs->numGroups; i > 0; --i)
+   {
+      FIXGroup* group = groups ? (FIXGroup*)(groups + groupStride * (i - 1)) :
+         (FIXGroup*)fix_utils_alloc(&attrs->allocator, sizeof(FIXGroup));
+      if (!group)
+      {
+         *error = fix_error_create(FIX_ERROR_MALLOC, "Unable to allocate group.");
+         return FIX_FAILED;
+      }
+      group->next = parser->group;
+      parser->group = group;
+   }
+   for(uint32_t i = attrs->numMsgs; i > 0; --i)
+   {
+      FIXMsg* msg = msgs ? (FIXMsg*)(msgs + msgStride * (i - 1)) :
+         (FIXMsg*)fix_utils_alloc(&attrs->allocator, sizeof(FIXMsg));
+      if (!msg)
+      {
+         *error = fix_error_create(FIX_ERROR_MALLOC, "Unable to allocate message.");
+         return FIX_FAILED;
+      }
+      msg->next = parser->msg;
+      parser->msg = msg;
+   }
+   return FIX_SUCCESS;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+static int32_t fix_parser_in_slab(FIXParser const* parser, void const* ptr)
+{
+   return parser->slab && (char const*)ptr >= parser->slab && (char const*)ptr < parser->slab + parser->slab_size;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+static FIXMsg* fix_parser_parse_msg(FIXParser* parser, FIXParseCtx* ctx, FIXMsg* target, char const* data, uint32_t len,
+      char delimiter, char const** stop, FIXError** error)
+{
    FIXTagNum tag = 0;
    char const* dbegin = NULL;
    char const* dend = NULL;
@@ -193,7 +682,7 @@ FIX_PARSER_API FIXMsg* fix_parser_str_to_msg(FIXParser* parser, char const* data
       *error = fix_error_create(FIX_ERROR_WRONG_FIELD, "First field is '%d', but must be BeginString.", tag);
       return NULL;
    }
-   if (strncmp(parser->protocol->transportVersion, dbegin, dend - dbegin))
+   if (dend - dbegin != ctx->verLen || memcmp(parser->protocol->transportVersion, dbegin, ctx->verLen))
    {
       char* actualVer = (char*)calloc(dend - dbegin + 1, 1);
       memcpy(actualVer, dbegin, dend - dbegin);
@@ -248,13 +737,7 @@ FIX_PARSER_API FIXMsg* fix_parser_str_to_msg(FIXParser* parser, char const* data
          *error = fix_error_create(FIX_ERROR_INVALID_ARGUMENT, "CheckSum value not a number.");
          return NULL;
       }
-      int32_t crc = 0;
-      for(char const* it = data; it <= bodyEnd; ++it)
-      {
-         crc += *it;
-      }
-      //printf("BODY = %.*s, SUM = %d, CRC = %d\n", bodyEnd - data, data, crc, (crc % 256));
-      crc %= 256;
+      int32_t const crc = fix_utils_checksum(data, bodyEnd - data + 1);
       //printf("CRC = %d, CRC1 = %d\n", crc, check_sum);
       if (crc != check_sum)
       {
@@ -273,14 +756,27 @@ FIX_PARSER_API FIXMsg* fix_parser_str_to_msg(FIXParser* parser, char const* data
       *error = fix_error_create(FIX_ERROR_WRONG_FIELD, "Field is '%d', but must be MsgType.", tag);
       return NULL;
    }
-   char* msgType = (char*)calloc(dend - dbegin + 1, 1);
-   memcpy(msgType, dbegin, dend - dbegin);
-   FIXMsg* msg = fix_msg_create(parser, msgType, error);
-   free(msgType);
-   if (!msg)
+   if (!ctx->descr || dend - dbegin != ctx->typeLen || memcmp(ctx->descr->type, dbegin, ctx->typeLen))
+   {
+      ctx->descr = fix_protocol_find_msg_descr(parser->protocol, dbegin, dend - dbegin);
+      if (!ctx->descr)
+      {
+         *error = fix_error_create(FIX_ERROR_UNKNOWN_MSG, "FIXMsgDescr with type '%.*s' not found", (int)(dend - dbegin), dbegin);
+         return NULL;
+      }
+      ctx->typeLen = dend - dbegin;
+      ctx->mask = fix_parser_get_projection(parser, ctx->descr);
+   }
+   FIXMsg* msg = target;
+   if (target && fix_msg_reset_by_descr(target, ctx->descr, error) == FIX_FAILED)
+   {
+      return NULL;
+   }
+   else if (!target && !(msg = fix_msg_create_by_descr(parser, ctx->descr, error)))
    {
       return NULL;
    }
+   msg->flags |= ctx->msgFlags;
    if (fix_msg_set_int32(msg, NULL, FIXFieldTag_BodyLength, bodyLen, error) != FIX_SUCCESS)
    {
       goto error;
@@ -292,9 +788,7 @@ FIX_PARSER_API FIXMsg* fix_parser_str_to_msg(FIXParser* parser, char const* data
             tag, msg->descr->name);
       goto error;
    }
-   char crc[4] = {};
-   memcpy(crc, crcbeg, *stop - crcbeg);
-   if (!fix_field_set(msg, NULL, fdescr, (unsigned char*)crcbeg, *stop - crcbeg, error))
+   if (!fix_parser_set_field(msg, NULL, fdescr, crcbeg, *stop - crcbeg, error))
    {
       goto error;
    }
@@ -306,7 +800,24 @@ FIX_PARSER_API FIXMsg* fix_parser_str_to_msg(FIXParser* parser, char const* data
       {
          goto error;
       }
-      if (fdescr) // if !fdescr, ignore this field
+      if (fdescr && ctx->mask && !ctx->mask[fdescr->ordinal]) // field is out of projection, skip it
+      {
+         if (fdescr->category == FIXFieldCategory_Group)
+         {
+            int64_t numGroups = 0;
+            FIXErrCode err = fix_utils_atoi64(dbegin, dend - dbegin + 1, delimiter, &numGroups, &cnt);
+            if (err < 0)
+            {
+               *error = fix_error_create(err, "Unable to get group tag %d value.", tag);
+               goto error;
+            }
+            if (FIX_FAILED == fix_parser_skip_group(fdescr, numGroups, dend, bodyEnd, delimiter, &dend, error))
+            {
+               goto error;
+            }
+         }
+      }
+      else if (fdescr) // if !fdescr, ignore this field
       {
          if (parser->flags & PARSER_FLAG_CHECK_VALUE)
          {
@@ -317,7 +828,7 @@ FIX_PARSER_API FIXMsg* fix_parser_str_to_msg(FIXParser* parser, char const* data
          }
          if (fdescr->category == FIXFieldCategory_Value)
          {
-            if (!fix_field_set(msg, NULL, fdescr, (unsigned char*)dbegin, dend - dbegin, error))
+            if (!fix_parser_set_field(msg, NULL, fdescr, dbegin, dend - dbegin, error))
             {
                goto error;
             }
@@ -343,7 +854,11 @@ FIX_PARSER_API FIXMsg* fix_parser_str_to_msg(FIXParser* parser, char const* data
       for(uint32_t i = 0; i < msg->descr->field_count; ++i)
       {
          FIXFieldDescr* fdescr = &msg->descr->fields[i];
-         if (fdescr->flags & FIELD_FLAG_REQUIRED && !fix_field_get(msg, NULL, fdescr->type->tag))
+         if (ctx->mask && !ctx->mask[fdescr->ordinal])
+         {
+            continue;
+         }
+         if (fdescr->flags & FIELD_FLAG_REQUIRED && !fix_field_get_by_descr(msg, NULL, fdescr))
          {
             *error = fix_error_create(FIX_ERROR_UNKNOWN_FIELD, "Required field '%s' not found.", fdescr->type->name);
             goto error;
@@ -352,10 +867,10 @@ FIX_PARSER_API FIXMsg* fix_parser_str_to_msg(FIXParser* parser, char const* data
    }
    return msg;
 error:
-   if (msg)
+   if (msg && msg != target)
    {
       fix_msg_free(msg);
-      msg = NULL;
    }
-   return msg;
+   return NULL;
 }
+
@@ -7,16 +7,22 @@
 #include "fix_parser_priv.h"
 #include "fix_utils.h"
 #include "fix_msg.h"
+#include "fix_msg_priv.h"
 #include "fix_error_priv.h"
 
 #include <string.h>
 #include <assert.h>
 
+#define ARENA_ALIGN(size) (((size) + 7) & ~7u)
+#define ARENA_MIN_PAGE 128      ///< minimal size of page carved from arena
+#define ARENA_DEFAULT_PAGE 512  ///< size of first page of message, if there is no statistics for its type yet
+
 /*------------------------------------------------------------------------------------------------------------------------*/
 FIXPage* fix_parser_alloc_page(FIXParser* parser, uint32_t pageSize, FIXError** error)
 {
    if (parser->attrs.maxPages > 0 && parser->attrs.maxPages == parser->used_pages)
    {
+      ++parser->stats.pages.failures;
       *error = fix_error_create(
          FIX_ERROR_NO_MORE_PAGES, "No more pages available. MaxPages = %d, UsedPages = %d", parser->attrs.maxPages, parser->used_pages);
       return NULL;
@@ -27,13 +33,21 @@ FIXPage* fix_parser_alloc_page(FIXParser* parser, uint32_t pageSize, FIXError**
       uint32_t psize = (parser->attrs.pageSize > pageSize ? parser->attrs.pageSize : pageSize);
       if (parser->attrs.maxPageSize > 0 && psize > parser->attrs.maxPageSize)
       {
+         ++parser->stats.pages.failures;
          *error = fix_error_create(
                FIX_ERROR_TOO_BIG_PAGE, "Requested new page is too big. MaxPageSize = %d, RequestedPageSize = %d",
                parser->attrs.maxPageSize, psize);
          return NULL;
       }
-      page = (FIXPage*)calloc(1, sizeof(FIXPage) + psize - 1);
+      page = (FIXPage*)fix_utils_alloc(&parser->attrs.allocator, sizeof(FIXPage) + psize - 1);
+      if (!page)
+      {
+         ++parser->stats.pages.failures;
+         *error = fix_error_create(FIX_ERROR_MALLOC, "Unable to allocate page of %d bytes.", psize);
+         return NULL;
+      }
       page->size = psize;
+      ++parser->stats.pages.overflows;
    }
    else
    {
@@ -42,14 +56,122 @@ FIXPage* fix_parser_alloc_page(FIXParser* parser, uint32_t pageSize, FIXError**
       page->next = NULL; // detach from pool of free pages
    }
    //assert( page->size >= pageSize );
-   ++parser->used_pages;
+   if (++parser->used_pages > parser->stats.pages.peak)
+   {
+      parser->stats.pages.peak = parser->used_pages;
+   }
    return page;
 }
 
+/*------------------------------------------------------------------------------------------------------------------------*/
+FIXPage* fix_parser_alloc_chunk(FIXParser* parser, uint32_t minSize, uint32_t size, FIXError** error)
+{
+   if (size > parser->attrs.pageSize)
+   {
+      size = parser->attrs.pageSize;
+   }
+   size = ARENA_ALIGN(size > minSize ? size : minSize);
+   uint32_t const total = ARENA_ALIGN(sizeof(FIXPage) - 1 + size);
+   if (!parser->attrs.arenaSize || minSize > parser->attrs.pageSize || total > parser->attrs.arenaSize)
+   {
+      return fix_parser_alloc_page(parser, minSize, error);
+   }
+   if (parser->attrs.maxPages > 0 && parser->attrs.maxPages == parser->used_pages)
+   {
+      ++parser->stats.pages.failures;
+      *error = fix_error_create(
+         FIX_ERROR_NO_MORE_PAGES, "No more pages available. MaxPages = %d, UsedPages = %d", parser->attrs.maxPages, parser->used_pages);
+      return NULL;
+   }
+   FIXArenaBlock* block = parser->arena;
+   if (!block || block->offset + total > block->size)
+   {
+      // current block stays alive until its last page is freed, then it goes to free list
+      block = parser->free_blocks;
+      if (block)
+      {
+         parser->free_blocks = block->next;
+      }
+      else
+      {
+         block = (FIXArenaBlock*)fix_utils_alloc(&parser->attrs.allocator, sizeof(FIXArenaBlock) + parser->attrs.arenaSize - 1);
+         if (!block)
+         {
+            ++parser->stats.pages.failures;
+            *error = fix_error_create(FIX_ERROR_MALLOC, "Unable to allocate arena block.");
+            return NULL;
+         }
+         block->size = parser->attrs.arenaSize;
+         ++parser->stats.arenaBlocks;
+      }
+      block->next = NULL;
+      parser->arena = block;
+   }
+   FIXPage* page = (FIXPage*)(block->data + block->offset);
+   block->offset += total;
+   ++block->live;
+   page->size = size;
+   page->offset = 0;
+   page->next = NULL;
+   page->block = block;
+   if (++parser->used_pages > parser->stats.pages.peak)
+   {
+      parser->stats.pages.peak = parser->used_pages;
+   }
+   return page;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+uint32_t fix_parser_msg_page_size(FIXParser const* parser, FIXMsgDescr const* descr)
+{
+   if (!parser->attrs.arenaSize)
+   {
+      return 0;
+   }
+   FIXMsgStats const* stats = &parser->msg_stats[descr->id];
+   if (!stats->count)
+   {
+      return ARENA_DEFAULT_PAGE;
+   }
+   uint32_t size = stats->avgSize + stats->avgSize / 4; // headroom, so most messages fit into one page
+   if (size < ARENA_MIN_PAGE)
+   {
+      size = ARENA_MIN_PAGE;
+   }
+   return size < parser->attrs.pageSize ? size : parser->attrs.pageSize;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+void fix_parser_update_msg_stats(FIXParser* parser, FIXMsgDescr const* descr, uint32_t size)
+{
+   FIXMsgStats* stats = &parser->msg_stats[descr->id];
+   stats->avgSize = stats->count ? stats->avgSize - stats->avgSize / 8 + size / 8 : size;
+   if (size > stats->maxSize)
+   {
+      stats->maxSize = size;
+   }
+   ++stats->count;
+}
+
 /*------------------------------------------------------------------------------------------------------------------------*/
 FIXPage* fix_parser_free_page(FIXParser* parser, FIXPage* page)
 {
    FIXPage* next = page->next;
+   FIXArenaBlock* block = page->block;
+   if (block)
+   {
+      if (--block->live == 0)
+      {
+         block->offset = 0;
+         if (block != parser->arena)
+         {
+            block->next = parser->free_blocks;
+            parser->free_blocks = block;
+         }
+      }
+      --parser->used_pages;
+      return next;
+   }
    page->offset = 0;
    page->next = parser->page;
    parser->page = page;
@@ -62,6 +184,7 @@ FIXGroup* fix_parser_alloc_group(FIXParser* parser, FIXError** error)
 {
    if (parser->attrs.maxGroups > 0 && parser->attrs.maxGroups == parser->used_groups)
    {
+      ++parser->stats.groups.failures;
       *error = fix_error_create(FIX_ERROR_NO_MORE_GROUPS,
          "No more groups available. MaxGroups = %d, UsedGroups = %d", parser->attrs.maxGroups, parser->used_groups);
       return NULL;
@@ -69,7 +192,14 @@ FIXGroup* fix_parser_alloc_group(FIXParser* parser, FIXError** error)
    FIXGroup* group = NULL;
    if (parser->group == NULL) // no more free group
    {
-      group = (FIXGroup*)calloc(1, sizeof(FIXGroup));
+      group = (FIXGroup*)fix_utils_alloc(&parser->attrs.allocator, sizeof(FIXGroup));
+      if (!group)
+      {
+         ++parser->stats.groups.failures;
+         *error = fix_error_create(FIX_ERROR_MALLOC, "Unable to allocate group.");
+         return NULL;
+      }
+      ++parser->stats.groups.overflows;
    }
    else
    {
@@ -77,7 +207,10 @@ FIXGroup* fix_parser_alloc_group(FIXParser* parser, FIXError** error)
       parser->group = group->next;
       group->next = NULL; // detach from pool
    }
-   ++parser->used_groups;
+   if (++parser->used_groups > parser->stats.groups.peak)
+   {
+      parser->stats.groups.peak = parser->used_groups;
+   }
    return group;
 }
 
@@ -85,13 +218,66 @@ FIXGroup* fix_parser_alloc_group(FIXParser* parser, FIXError** error)
 FIXGroup* fix_parser_free_group(FIXParser* parser, FIXGroup* group)
 {
    FIXGroup* next = group->next;
-   memset(group, 0, sizeof(FIXGroup));
-   group->next = parser->group;
+   group->next = parser->group; // other members are reinitialized by fix_msg_alloc_group
    parser->group = group;
    --parser->used_groups;
    return next;
 }
 
+/*------------------------------------------------------------------------------------------------------------------------*/
+FIXMsg* fix_parser_alloc_msg(FIXParser* parser, FIXError** error)
+{
+   if (parser->attrs.maxMsgs > 0 && parser->attrs.maxMsgs == parser->used_msgs)
+   {
+      ++parser->stats.msgs.failures;
+      *error = fix_error_create(FIX_ERROR_NO_MORE_MSGS,
+         "No more messages available. MaxMsgs = %d, UsedMsgs = %d", parser->attrs.maxMsgs, parser->used_msgs);
+      return NULL;
+   }
+   FIXMsg* msg = NULL;
+   if (parser->msg == NULL) // no more free messages
+   {
+      msg = (FIXMsg*)fix_utils_alloc(&parser->attrs.allocator, sizeof(FIXMsg));
+      if (!msg)
+      {
+         ++parser->stats.msgs.failures;
+         *error = fix_error_create(FIX_ERROR_MALLOC, "Unable to allocate message.");
+         return NULL;
+      }
+      ++parser->stats.msgs.overflows;
+   }
+   else
+   {
+      msg = parser->msg;
+      parser->msg = msg->next;
+      msg->next = NULL; // detach from pool
+   }
+   if (++parser->used_msgs > parser->stats.msgs.peak)
+   {
+      parser->stats.msgs.peak = parser->used_msgs;
+   }
+   return msg;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+void fix_parser_free_msg(FIXParser* parser, FIXMsg* msg)
+{
+   msg->next = parser->msg;
+   parser->msg = msg;
+   --parser->used_msgs;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+FIXField* fix_parser_set_field(FIXMsg* msg, FIXGroup* group, FIXFieldDescr const* fdescr, char const* dbegin, uint32_t len,
+      FIXError** error)
+{
+   if (msg->flags & MSG_FLAG_VIEW)
+   {
+      return fix_field_set_ref(msg, group, fdescr, dbegin, len, error);
+   }
+   return fix_field_set(msg, group, fdescr, (unsigned char const*)dbegin, len, error);
+}
+
 /*------------------------------------------------------------------------------------------------------------------------*/
 int32_t fix_parser_validate_attrs(FIXParserAttrs* attrs, FIXError** error)
 {
@@ -107,6 +293,10 @@ int32_t fix_parser_validate_attrs(FIXParserAttrs* attrs, FIXError** error)
    {
       attrs->numGroups = 1000;
    }
+   if (!attrs->numMsgs)
+   {
+      attrs->numMsgs = 1000;
+   }
    if (attrs->maxPageSize > 0 && attrs->maxPageSize < attrs->pageSize)
    {
       *error = fix_error_create(FIX_ERROR_INVALID_ARGUMENT, "ERROR: Parser attbutes are invalid: MaxPageSize < PageSize.");
@@ -122,9 +312,52 @@ int32_t fix_parser_validate_attrs(FIXParserAttrs* attrs, FIXError** error)
       *error = fix_error_create(FIX_ERROR_INVALID_ARGUMENT, "Parser attbutes are invalid: MaxGroups < NumGroups.");
       return FIX_FAILED;
    }
+   if (attrs->maxMsgs > 0 && attrs->maxMsgs < attrs->numMsgs)
+   {
+      *error = fix_error_create(FIX_ERROR_INVALID_ARGUMENT, "Parser attbutes are invalid: MaxMsgs < NumMsgs.");
+      return FIX_FAILED;
+   }
+   if (attrs->arenaSize > 0 && attrs->arenaSize < attrs->pageSize)
+   {
+      *error = fix_error_create(FIX_ERROR_INVALID_ARGUMENT, "Parser attbutes are invalid: ArenaSize < PageSize.");
+      return FIX_FAILED;
+   }
+   if (!attrs->allocator.alloc != !attrs->allocator.free)
+   {
+      *error = fix_error_create(FIX_ERROR_INVALID_ARGUMENT, "Parser attbutes are invalid: both Allocator.alloc and Allocator.free must be set.");
+      return FIX_FAILED;
+   }
+   if (attrs->poolFlags & ~POOL_FLAG_ALL)
+   {
+      *error = fix_error_create(FIX_ERROR_INVALID_ARGUMENT, "Parser attbutes are invalid: unknown PoolFlags 0x%x.", attrs->poolFlags);
+      return FIX_FAILED;
+   }
    return FIX_SUCCESS;
 }
 
+/*------------------------------------------------------------------------------------------------------------------------*/
+static int32_t fix_parser_is_float(char const* dbegin, char const* dend)
+{
+   int32_t digits = 0;
+   int32_t dots = 0;
+   if (dbegin < dend && *dbegin == '-')
+   {
+      ++dbegin;
+   }
+   for(; dbegin < dend; ++dbegin)
+   {
+      if (*dbegin >= '0' && *dbegin <= '9')
+      {
+         ++digits;
+      }
+      else if (*dbegin != '.' || ++dots > 1)
+      {
+         return 0;
+      }
+   }
+   return digits > 0;
+}
+
 /*------------------------------------------------------------------------------------------------------------------------*/
 FIXErrCode fix_parser_check_value(FIXFieldDescr const* fdescr, char const* dbegin, char const* dend, char delimiter,
       FIXError** error)
@@ -146,9 +379,7 @@ FIXErrCode fix_parser_check_value(FIXFieldDescr const* fdescr, char const* dbegi
    }
    else if (IS_FLOAT_TYPE(fdescr->type->valueType))
    {
-      double res = 0.0;
-      int32_t cnt;
-      if (!fix_utils_atod(dbegin, dend - dbegin, delimiter, &res, &cnt))
+      if (!fix_parser_is_float(dbegin, dend))
       {
          *error = fix_error_create(FIX_ERROR_WRONG_FIELD_VALUE, "Wrong field '%s' value.", fdescr->type->name);
          return FIX_FAILED;
@@ -183,18 +414,8 @@ static FIXErrCode fix_parser_parse_value(FIXMsg* msg, FIXGroup* group, FIXFieldD
    }
    else // get value till delimiter
    {
-      for(;len > 0; --len)
-      {
-         if (**dend == delimiter)
-         {
-            break;
-         }
-         else
-         {
-            ++(*dend);
-         }
-      }
-      if (!len)
+      *dend = fix_utils_find_char(dbegin, len, delimiter);
+      if (!*dend)
       {
          *error = fix_error_create(FIX_ERROR_NO_MORE_DATA, "Field value must be terminated with '%c' delimiter.", delimiter);
          return FIX_FAILED;
@@ -299,7 +520,7 @@ FIXErrCode fix_parser_parse_group(
                FIXFieldDescr* fdescr = &gdescr->group[i];
                if (fdescr->flags & FIELD_FLAG_REQUIRED)
                {
-                  if (!fix_field_get(msg, group, fdescr->type->tag))
+                  if (!fix_field_get_by_descr(msg, group, fdescr))
                   {
                      *error = fix_error_create(FIX_ERROR_FIELD_NOT_FOUND,
                            "Required field '%s' not found in group '%s'.",
@@ -349,7 +570,7 @@ FIXErrCode fix_parser_parse_group(
       }
       if (fdescr->category == FIXFieldCategory_Value)
       {
-         if (!fix_field_set(msg, group, fdescr, (unsigned char*)dbegin, *stop - dbegin, error))
+         if (!fix_parser_set_field(msg, group, fdescr, dbegin, *stop - dbegin, error))
          {
             return FIX_FAILED;
          }
@@ -376,3 +597,83 @@ FIXErrCode fix_parser_parse_group(
    }
    return FIX_SUCCESS;
 }
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+FIXErrCode fix_parser_skip_group(FIXFieldDescr const* gdescr, int64_t numGroups, char const* data, char const* bodyEnd,
+      char delimiter, char const** stop, FIXError** error)
+{
+   int64_t groupCount = 0;
+   int64_t dataLen = -1; // value of last Length field, it precedes Data field
+   *stop = data;
+   while(numGroups && bodyEnd != *stop)
+   {
+      FIXTagNum tag = 0;
+      char const* dbegin = NULL;
+      char const* dend = NULL;
+      if(FIX_FAILED == fix_parser_parse_tag(NULL, NULL, *stop + 1, bodyEnd - *stop, &tag, NULL, &dbegin, error))
+      {
+         return FIX_FAILED;
+      }
+      FIXFieldDescr const* fdescr = fix_protocol_get_group_descr(gdescr, tag);
+      if (tag == gdescr->group[0].type->tag) // start of new group
+      {
+         ++groupCount;
+      }
+      else if (!fdescr || !groupCount)
+      {
+         if (groupCount == numGroups) // looks like we finished
+         {
+            return FIX_SUCCESS;
+         }
+         *error = fix_error_create(
+               FIX_ERROR_UNKNOWN_FIELD, "Field '%d' not found in group '%s' description.", tag, gdescr->type->name);
+         return FIX_FAILED;
+      }
+      if (fdescr->type->valueType == FIXFieldValueType_Data && dataLen >= 0)
+      {
+         dend = dbegin + dataLen;
+         if (dend > bodyEnd || *dend != delimiter)
+         {
+            *error = fix_error_create(FIX_ERROR_WRONG_FIELD, "Field '%d' length mismatch.", tag);
+            return FIX_FAILED;
+         }
+      }
+      else if (FIX_FAILED == fix_parser_parse_value(NULL, NULL, NULL, dbegin, bodyEnd - dbegin + 1, delimiter, &dend, error))
+      {
+         return FIX_FAILED;
+      }
+      dataLen = -1;
+      *stop = dend;
+      if (fdescr->type->valueType == FIXFieldValueType_Length || fdescr->category == FIXFieldCategory_Group)
+      {
+         int64_t val = 0;
+         int32_t cnt;
+         FIXErrCode err = fix_utils_atoi64(dbegin, dend - dbegin, 0, &val, &cnt);
+         if (err < 0)
+         {
+            *error = fix_error_create(err, "Unable to get field '%d' value.", tag);
+            return FIX_FAILED;
+         }
+         if (fdescr->category == FIXFieldCategory_Group &&
+             FIX_FAILED == fix_parser_skip_group(fdescr, val, dend, bodyEnd, delimiter, stop, error))
+         {
+            return FIX_FAILED;
+         }
+         dataLen = fdescr->category == FIXFieldCategory_Group ? -1 : val;
+      }
+   }
+   return FIX_SUCCESS;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+uint8_t const* fix_parser_get_projection(FIXParser const* parser, FIXMsgDescr const* descr)
+{
+   for(FIXProjection const* proj = parser->projections; proj; proj = proj->next)
+   {
+      if (proj->descr == descr)
+      {
+         return proj->mask;
+      }
+   }
+   return NULL;
+}
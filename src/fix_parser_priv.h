@@ -20,6 +20,16 @@ extern "C"
 {
 #endif
 
+/**
+ * set of message fields, which are stored by parser
+ */
+typedef struct FIXProjection_
+{
+   FIXMsgDescr const* descr;           ///< description of projected message
+   uint8_t* mask;                      ///< non-zero, if field with such ordinal must be stored
+   struct FIXProjection_* next;        ///< next projection of parser
+} FIXProjection;
+
 /**
  * FIX parser data
  */
@@ -32,6 +42,15 @@ struct FIXParser_
    uint32_t used_pages;                ///< count of memory pages in use
    FIXGroup* group;                    ///< allocated FIX groups
    uint32_t used_groups;               ///< count of used groups
+   FIXMsg* msg;                        ///< allocated FIX messages
+   uint32_t used_msgs;                 ///< count of used messages
+   FIXProjection* projections;         ///< registered projections of message types
+   char* slab;                         ///< region with preallocated pages, groups and messages, if POOL_FLAG_* is set
+   uint64_t slab_size;                 ///< size of slab
+   FIXArenaBlock* arena;               ///< arena block, new small pages are carved from. Only if attrs.arenaSize > 0
+   FIXArenaBlock* free_blocks;         ///< arena blocks without live pages
+   FIXMsgStats* msg_stats;             ///< memory usage of messages, indexed by FIXMsgDescr::id
+   FIXParserStats stats;               ///< pool counters. Members used and free are filled by fix_parser_get_stats only
 };
 
 /**
@@ -51,6 +70,33 @@ FIXPage* fix_parser_alloc_page(FIXParser* parser, uint32_t pageSize, FIXError**
  */
 FIXPage* fix_parser_free_page(FIXParser* parser, FIXPage* page);
 
+/**
+ * allocate page for message data. If arena is on, page of desired size is carved from arena block, otherwise it is
+ * usual page from pool
+ * @param[in] parser - FIX parser
+ * @param[in] minSize - minimal size of page
+ * @param[in] size - desired size of page, used by arena only
+ * @param[out] error - error description
+ * @return allocated page, NULL - if allocated page exceeded parser attributes
+ */
+FIXPage* fix_parser_alloc_chunk(FIXParser* parser, uint32_t minSize, uint32_t size, FIXError** error);
+
+/**
+ * return desired size of the first page of message, based on statistics of its type
+ * @param[in] parser - FIX parser
+ * @param[in] descr - message description
+ * @return page size, 0 - default page size
+ */
+uint32_t fix_parser_msg_page_size(FIXParser const* parser, FIXMsgDescr const* descr);
+
+/**
+ * account page space used by message
+ * @param[in] parser - FIX parser
+ * @param[in] descr - message description
+ * @param[in] size - bytes used by message
+ */
+void fix_parser_update_msg_stats(FIXParser* parser, FIXMsgDescr const* descr, uint32_t size);
+
 /**
  * allocate new FIX group
  * @param[in] parser - group allocator
@@ -67,6 +113,21 @@ FIXGroup* fix_parser_alloc_group(FIXParser* parser, FIXError** error);
  */
 FIXGroup* fix_parser_free_group(FIXParser* parser, FIXGroup* group);
 
+/**
+ * allocate new FIX message header
+ * @param[in] parser - message allocator
+ * @param[out] error - error description
+ * @return allocated message or NULL if parser attributes are exceeded
+ */
+FIXMsg* fix_parser_alloc_msg(FIXParser* parser, FIXError** error);
+
+/**
+ * free allocated message header
+ * @param[in] parser - message holder
+ * @param[in] msg - deallocated message
+ */
+void fix_parser_free_msg(FIXParser* parser, FIXMsg* msg);
+
 /**
  * parse string with mandatory fields. Mandatory fields are BeginString, BodyLength, CheckSum, MsgType
  * @param[in] data - string to parse
@@ -98,6 +159,19 @@ FIXTagNum fix_parser_parse_field(
       FIXParser* parser, FIXMsg* msg, FIXGroup* group, char const* data, uint32_t len, char delimiter, FIXFieldDescr const** fdescr,
       char const** dbegin, char const** dend, FIXError** error);
 
+/**
+ * store parsed field value. Value is referenced if message is a view (MSG_FLAG_VIEW), else value is copied
+ * @param[in] msg - FIX message, which will hold parsed field
+ * @param[in] group - FIX group, which will hold parsed field. Can be NULL
+ * @param[in] fdescr - description of field
+ * @param[in] dbegin - begin of field value
+ * @param[in] len - length of field value
+ * @param[out] error - error description
+ * @return stored FIX field, NULL - see error description
+ */
+FIXField* fix_parser_set_field(FIXMsg* msg, FIXGroup* group, FIXFieldDescr const* fdescr, char const* dbegin, uint32_t len,
+      FIXError** error);
+
 /**
  * validate parser attributes
  * @param[in] attrs - attributes to validate
@@ -143,6 +217,28 @@ FIXErrCode fix_parser_check_value(FIXFieldDescr const* fdescr, char const* dbegi
 FIXErrCode fix_parser_parse_group(FIXParser* parser, FIXMsg* msg, FIXGroup* parentGroup, FIXFieldDescr const* gdescr, int64_t numGroups,
       char const* data, char const* bodyEnd, char delimiter, char const** stop, FIXError** error);
 
+/**
+ * skip string with group without storing its fields
+ * @param[in] gdescr - FIX group description
+ * @param[in] numGroups - count of group entries
+ * @param[in] data - string to skip
+ * @param[in] bodyEnd - end of data to skip
+ * @param[in] delimiter - FIX field SOH
+ * @param[out] stop - skip stop pointer
+ * @param[out] error - error description
+ * @return FIX_SUCCESS - ok, FIX_FAILED - error
+ */
+FIXErrCode fix_parser_skip_group(FIXFieldDescr const* gdescr, int64_t numGroups, char const* data, char const* bodyEnd,
+      char delimiter, char const** stop, FIXError** error);
+
+/**
+ * return projection mask of message
+ * @param[in] parser - FIX parser
+ * @param[in] descr - message description
+ * @return mask indexed by field ordinal, NULL - message is not projected
+ */
+uint8_t const* fix_parser_get_projection(FIXParser const* parser, FIXMsgDescr const* descr);
+
 #ifdef __cplusplus
 }
 #endif
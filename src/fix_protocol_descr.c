@@ -18,6 +18,14 @@
 #include <stdint.h>
 #include <limits.h>
 #include <assert.h>
+#ifdef WIN32
+#  include <windows.h>
+#  define ATOMIC_INC(x) InterlockedIncrement((LONG volatile*)(x))
+#  define ATOMIC_DEC(x) InterlockedDecrement((LONG volatile*)(x))
+#else
+#  define ATOMIC_INC(x) __sync_add_and_fetch(x, 1)
+#  define ATOMIC_DEC(x) __sync_sub_and_fetch(x, 1)
+#endif
 
 /*-----------------------------------------------------------------------------------------------------------------------*/
 /* PRIVATES                                                                                                              */
@@ -94,18 +102,19 @@ static xmlNode* get_first(xmlNode const* node, char const* name)
 }
 
 /*-----------------------------------------------------------------------------------------------------------------------*/
-static void free_field_descr(FIXFieldDescr* fd)
+static void free_field_descr(FIXAllocator const* allocator, FIXFieldDescr* fd)
 {
    for(uint32_t i = 0; i < fd->group_count; ++i)
    {
-      free_field_descr(&fd->group[i]);
+      free_field_descr(allocator, &fd->group[i]);
    }
-   free(fd->group);
-   free(fd->group_index);
+   fix_utils_free(allocator, fd->group);
+   fix_utils_free(allocator, fd->group_index.dense);
+   fix_utils_free(allocator, fd->group_index.hash);
 }
 
 /*-----------------------------------------------------------------------------------------------------------------------*/
-static void free_field_type(FIXFieldType const* ft)
+static void free_field_type(FIXAllocator const* allocator, FIXFieldType const* ft)
 {
    if (ft->values)
    {
@@ -115,33 +124,35 @@ static void free_field_type(FIXFieldType const* ft)
          while(fval)
          {
             FIXFieldValue* next = fval->next;
-            free((void*)fval->value);
-            free((void*)fval);
+            fix_utils_free(allocator, (void*)fval->value);
+            fix_utils_free(allocator, fval);
             fval = next;
          }
       }
-      free((void*)ft->values);
+      fix_utils_free(allocator, ft->values);
    }
-   free(ft->name);
-   free((void*)ft);
+   fix_utils_free(allocator, ft->name);
+   fix_utils_free(allocator, (void*)ft);
 }
 
 /*-----------------------------------------------------------------------------------------------------------------------*/
-static void free_message(FIXMsgDescr const* msg)
+static void free_message(FIXAllocator const* allocator, FIXMsgDescr const* msg)
 {
-   free(msg->name);
-   free(msg->type);
-   free(msg->field_index);
+   fix_utils_free(allocator, msg->name);
+   fix_utils_free(allocator, msg->type);
+   fix_utils_free(allocator, msg->field_index.dense);
+   fix_utils_free(allocator, msg->field_index.hash);
    for(uint32_t i = 0; i < msg->field_count; ++i)
    {
-      free_field_descr(&msg->fields[i]);
+      free_field_descr(allocator, &msg->fields[i]);
    }
-   free(msg->fields);
-   free((void*)msg);
+   fix_utils_free(allocator, msg->fields);
+   fix_utils_free(allocator, (void*)msg);
 }
 
 /*-----------------------------------------------------------------------------------------------------------------------*/
-static FIXErrCode load_field_types(FIXFieldType* (*ftypes)[FIELD_TYPE_CNT], xmlNode const* root, FIXError** error)
+static FIXErrCode load_field_types(FIXAllocator const* allocator, FIXFieldType* (*ftypes)[FIELD_TYPE_CNT], xmlNode const* root,
+      FIXError** error)
 {
    xmlNode const* field = get_first(get_first(root, "fields"), "field");
    while(field)
@@ -153,20 +164,43 @@ static FIXErrCode load_field_types(FIXFieldType* (*ftypes)[FIELD_TYPE_CNT], xmlN
             *error = fix_error_create(FIX_ERROR_FIELD_TYPE_EXISTS, "FIXFieldType '%s' already exists", (char const*)field->name);
             return FIX_FAILED;
          }
-         FIXFieldType* fld = (FIXFieldType*)calloc(1, sizeof(FIXFieldType));
+         FIXFieldType* fld = (FIXFieldType*)fix_utils_alloc(allocator, sizeof(FIXFieldType));
+         if (!fld)
+         {
+            goto nomem;
+         }
          fld->tag = atoi(get_attr(field, "number", NULL));
-         fld->name = _strdup(get_attr(field, "name", NULL));
+         fld->name = fix_utils_strdup(allocator, get_attr(field, "name", NULL));
+         if (!fld->name)
+         {
+            free_field_type(allocator, fld);
+            goto nomem;
+         }
          fld->valueType = str2FIXFieldValueType(get_attr(field, "type", NULL));
          xmlNode const* value = get_first(field, "value");
          if (value)
          {
-            fld->values = (FIXFieldValue**)calloc(FIELD_VALUE_CNT, sizeof(FIXFieldValue*));
+            fld->values = (FIXFieldValue**)fix_utils_alloc(allocator, FIELD_VALUE_CNT * sizeof(FIXFieldValue*));
+            if (!fld->values)
+            {
+               free_field_type(allocator, fld);
+               goto nomem;
+            }
             while(value)
             {
                if (value->type == XML_ELEMENT_NODE && !strcmp((char const*)value->name, "value"))
                {
-                  FIXFieldValue* val = (FIXFieldValue*)calloc(1, sizeof(FIXFieldValue));
-                  val->value = strdup(get_attr(value, "enum", NULL));
+                  FIXFieldValue* val = (FIXFieldValue*)fix_utils_alloc(allocator, sizeof(FIXFieldValue));
+                  if (val)
+                  {
+                     val->value = fix_utils_strdup(allocator, get_attr(value, "enum", NULL));
+                  }
+                  if (!val || !val->value)
+                  {
+                     fix_utils_free(allocator, val);
+                     free_field_type(allocator, fld);
+                     goto nomem;
+                  }
                   uint32_t idx = fix_utils_hash_string(val->value, strlen(val->value)) % FIELD_VALUE_CNT;
                   val->next = fld->values[idx];
                   fld->values[idx] = val;
@@ -181,6 +215,9 @@ static FIXErrCode load_field_types(FIXFieldType* (*ftypes)[FIELD_TYPE_CNT], xmlN
       field = field->next;
    }
    return FIX_SUCCESS;
+nomem:
+   *error = fix_error_create(FIX_ERROR_MALLOC, "Unable to allocate field type.");
+   return FIX_FAILED;
 }
 
 /*-----------------------------------------------------------------------------------------------------------------------*/
@@ -222,7 +259,31 @@ static uint32_t count_msg_fields(xmlNode const* msg_node, xmlNode const* compone
 }
 
 /*-----------------------------------------------------------------------------------------------------------------------*/
-static FIXErrCode load_fields(
+static void make_field_plan(FIXFieldDescr* fld)
+{
+   if (fld->category == FIXFieldCategory_Group)
+   {
+      fld->emit = FIELD_EMIT_GROUP;
+   }
+   else if (fld->type->tag == FIXFieldTag_BodyLength)
+   {
+      fld->emit = FIELD_EMIT_BODY_LENGTH;
+   }
+   else if (fld->type->tag == FIXFieldTag_CheckSum)
+   {
+      fld->emit = FIELD_EMIT_CHECKSUM;
+   }
+   else
+   {
+      fld->emit = FIELD_EMIT_VALUE;
+   }
+   int32_t const len = fix_utils_i64toa(fld->type->tag, fld->prefix, FIELD_PREFIX_LEN - 1, 0);
+   fld->prefix[len] = '=';
+   fld->prefix_len = len + 1;
+}
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+static FIXErrCode load_fields(FIXAllocator const* allocator,
       FIXFieldDescr* fields, uint32_t* count, xmlNode const* msg_node, xmlNode const* components,
       FIXFieldType* (*ftypes)[FIELD_TYPE_CNT], FIXError** error)
 {
@@ -245,6 +306,7 @@ static FIXErrCode load_fields(
          {
             fld->flags |= FIELD_FLAG_REQUIRED;
          }
+         make_field_plan(fld);
          if (fld->type->valueType == FIXFieldValueType_Data)
          {
             if ((*count) < 2)
@@ -273,7 +335,7 @@ static FIXErrCode load_fields(
                char const* name = get_attr(component, "name", NULL);
                if (!strcmp(component_name, name))
                {
-                  if (FIX_FAILED == load_fields(fields, count, component, components, ftypes, error))
+                  if (FIX_FAILED == load_fields(allocator, fields, count, component, components, ftypes, error))
                   {
                      return FIX_FAILED;
                   }
@@ -299,11 +361,17 @@ static FIXErrCode load_fields(
          {
             fld->flags |= FIELD_FLAG_REQUIRED;
          }
-         fld->group_index = (FIXFieldDescr**)calloc(FIELD_DESCR_CNT, sizeof(FIXFieldDescr*));
+         make_field_plan(fld);
          fld->group_count = count_msg_fields(field, components);
-         fld->group = (FIXFieldDescr*)calloc(fld->group_count, sizeof(FIXFieldDescr));
+         fld->group = (FIXFieldDescr*)fix_utils_alloc(allocator, (fld->group_count ? fld->group_count : 1) * sizeof(FIXFieldDescr));
+         if (!fld->group)
+         {
+            fld->group_count = 0; // nothing to release
+            *error = fix_error_create(FIX_ERROR_MALLOC, "Unable to allocate group '%s' description.", name);
+            return FIX_FAILED;
+         }
          uint32_t count1 = 0;
-         if (FIX_FAILED == load_fields(fld->group, &count1, field, components, ftypes, error))
+         if (FIX_FAILED == load_fields(allocator, fld->group, &count1, field, components, ftypes, error))
          {
             return FIX_FAILED;
          }
@@ -314,39 +382,159 @@ static FIXErrCode load_fields(
 }
 
 /*-----------------------------------------------------------------------------------------------------------------------*/
-static void build_index(FIXFieldDescr* fields, uint32_t field_count, FIXFieldDescr** index)
+static int32_t build_hash(FIXFieldDescr const* fields, uint16_t const* pos, uint32_t count, uint32_t bits, uint32_t seed,
+      FIXTagIndex* index)
+{
+   uint32_t const size = 1u << bits;
+   memset(index->hash, 0, size * sizeof(uint16_t));
+   index->hash_seed = seed;
+   index->hash_shift = 32 - bits;
+   for(uint32_t i = 0; i < count; ++i)
+   {
+      uint32_t const idx = ((uint32_t)fields[pos[i] - 1].type->tag * seed) >> index->hash_shift;
+      if (index->hash[idx])
+      {
+         return 0;
+      }
+      index->hash[idx] = pos[i];
+   }
+   return 1;
+}
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+static FIXErrCode build_index(FIXAllocator const* allocator, FIXFieldDescr* fields, uint32_t field_count, FIXTagIndex* index,
+      FIXError** error)
 {
+   FIXTagNum min_tag = FIELD_DENSE_TAG_LIMIT;
+   FIXTagNum max_tag = -1;
+   uint32_t hash_count = 0;
    for(uint32_t i = 0; i < field_count; ++i)
    {
-      FIXFieldDescr* fld = &fields[i];
-      int32_t idx = fld->type->tag % FIELD_DESCR_CNT;
-      fld->next = index[idx];
-      index[idx] = fld;
-      if (fld->group_count)
+      FIXTagNum const tag = fields[i].type->tag;
+      if (tag >= FIELD_DENSE_TAG_LIMIT)
+      {
+         ++hash_count;
+      }
+      else
       {
-         build_index(fld->group, fld->group_count, fld->group_index);
+         min_tag = tag < min_tag ? tag : min_tag;
+         max_tag = tag > max_tag ? tag : max_tag;
+      }
+      if (fields[i].group_count &&
+            FIX_FAILED == build_index(allocator, fields[i].group, fields[i].group_count, &fields[i].group_index, error))
+      {
+         return FIX_FAILED;
       }
    }
+   index->dense_min = max_tag < 0 ? 0 : min_tag;
+   index->dense_size = max_tag < 0 ? 0 : max_tag - min_tag + 1;
+   index->dense = (uint16_t*)fix_utils_alloc(allocator, (index->dense_size ? index->dense_size : 1) * sizeof(uint16_t));
+   uint16_t* hash_pos = (uint16_t*)fix_utils_alloc(allocator, (hash_count ? hash_count : 1) * sizeof(uint16_t));
+   if (!index->dense || !hash_pos) // index is released by owner of fields
+   {
+      goto nomem;
+   }
+   hash_count = 0;
+   for(uint32_t i = 0; i < field_count; ++i) // if tag is duplicated, last description wins
+   {
+      FIXTagNum const tag = fields[i].type->tag;
+      if (tag < FIELD_DENSE_TAG_LIMIT)
+      {
+         index->dense[tag - index->dense_min] = i + 1;
+         continue;
+      }
+      uint32_t j = 0;
+      while(j < hash_count && fields[hash_pos[j] - 1].type->tag != tag)
+      {
+         ++j;
+      }
+      hash_pos[j] = i + 1;
+      hash_count += (j == hash_count);
+   }
+   index->hash = NULL;
+   if (hash_count)
+   {
+      // look for collision-free multiplier, growing the table if it's too crowded
+      uint32_t bits = 1;
+      while((1u << bits) < hash_count * 2)
+      {
+         ++bits;
+      }
+      index->hash = (uint16_t*)fix_utils_alloc(allocator, sizeof(uint16_t) << bits);
+      uint32_t seed = 0x9E3779B1;
+      for(uint32_t attempt = 1; index->hash && !build_hash(fields, hash_pos, hash_count, bits, seed | 1, index); ++attempt)
+      {
+         seed = seed * 1664525 + 1013904223;
+         if (attempt % 256 == 0)
+         {
+            ++bits;
+            fix_utils_free(allocator, index->hash); // table is rebuilt from scratch, no need to keep content
+            index->hash = (uint16_t*)fix_utils_alloc(allocator, sizeof(uint16_t) << bits);
+         }
+      }
+      if (!index->hash)
+      {
+         goto nomem;
+      }
+   }
+   for(uint32_t i = 0; i < field_count; ++i) // duplicated tags share slot of description which wins
+   {
+      FIXTagNum const tag = fields[i].type->tag;
+      if (tag < FIELD_DENSE_TAG_LIMIT)
+      {
+         fields[i].ordinal = index->dense[tag - index->dense_min] - 1;
+         continue;
+      }
+      uint32_t j = 0;
+      while(fields[hash_pos[j] - 1].type->tag != tag)
+      {
+         ++j;
+      }
+      fields[i].ordinal = hash_pos[j] - 1;
+   }
+   fix_utils_free(allocator, hash_pos);
+   return FIX_SUCCESS;
+nomem:
+   fix_utils_free(allocator, hash_pos);
+   *error = fix_error_create(FIX_ERROR_MALLOC, "Unable to allocate field index.");
+   return FIX_FAILED;
 }
 
 /*-----------------------------------------------------------------------------------------------------------------------*/
-static FIXMsgDescr* load_message(xmlNode const* msg_node, xmlNode const* root,
+static FIXMsgDescr* load_message(FIXAllocator const* allocator, xmlNode const* msg_node, xmlNode const* root,
       FIXFieldType* (*ftypes)[FIELD_TYPE_CNT], FIXError** error)
 {
-   FIXMsgDescr* msg = (FIXMsgDescr*)calloc(1, sizeof(FIXMsgDescr));
-   msg->name = _strdup(get_attr(msg_node, "name", NULL));
-   msg->type = _strdup(get_attr(msg_node, "type", NULL));
-   msg->field_count = count_msg_fields(msg_node, get_first(root, "components"));
-   msg->fields = (FIXFieldDescr*)calloc(msg->field_count, sizeof(FIXFieldDescr));
-   uint32_t count = 0;
-   if (FIX_FAILED == load_fields(msg->fields, &count, msg_node, get_first(root, "components"), ftypes, error))
+   FIXMsgDescr* msg = (FIXMsgDescr*)fix_utils_alloc(allocator, sizeof(FIXMsgDescr));
+   if (!msg)
    {
+      *error = fix_error_create(FIX_ERROR_MALLOC, "Unable to allocate message description.");
       return NULL;
    }
+   msg->name = fix_utils_strdup(allocator, get_attr(msg_node, "name", NULL));
+   msg->type = fix_utils_strdup(allocator, get_attr(msg_node, "type", NULL));
+   uint32_t const field_count = count_msg_fields(msg_node, get_first(root, "components"));
+   msg->fields = (FIXFieldDescr*)fix_utils_alloc(allocator, (field_count ? field_count : 1) * sizeof(FIXFieldDescr));
+   if (!msg->name || !msg->type || !msg->fields)
+   {
+      *error = fix_error_create(FIX_ERROR_MALLOC, "Unable to allocate message description.");
+      goto err;
+   }
+   msg->type_key = fix_protocol_pack_msg_type(msg->type, strlen(msg->type));
+   msg->field_count = field_count;
+   uint32_t count = 0;
+   if (FIX_FAILED == load_fields(allocator, msg->fields, &count, msg_node, get_first(root, "components"), ftypes, error))
+   {
+      goto err;
+   }
    assert(count == msg->field_count);
-   msg->field_index = (FIXFieldDescr**)calloc(FIELD_DESCR_CNT, sizeof(FIXFieldDescr*));
-   build_index(msg->fields, msg->field_count, msg->field_index);
+   if (FIX_FAILED == build_index(allocator, msg->fields, msg->field_count, &msg->field_index, error))
+   {
+      goto err;
+   }
    return msg;
+err:
+   free_message(allocator, msg);
+   return NULL;
 }
 
 /*-----------------------------------------------------------------------------------------------------------------------*/
@@ -358,11 +546,12 @@ static int32_t load_messages(FIXProtocolDescr* prot, FIXFieldType* (*ftypes)[FIE
    {
       if (msg_node->type == XML_ELEMENT_NODE && !strcmp((char const*)msg_node->name, "message"))
       {
-         FIXMsgDescr* msg = load_message(msg_node, root, ftypes, error);
+         FIXMsgDescr* msg = load_message(&prot->allocator, msg_node, root, ftypes, error);
          if (!msg)
          {
             return FIX_FAILED;
          }
+         msg->id = prot->msg_count++;
          int32_t idx = fix_utils_hash_string(msg->type, strlen(msg->type)) % MSG_CNT;
          msg->next = prot->messages[idx];
          prot->messages[idx] = msg;
@@ -372,6 +561,84 @@ static int32_t load_messages(FIXProtocolDescr* prot, FIXFieldType* (*ftypes)[FIE
    return FIX_SUCCESS;
 }
 
+/*-----------------------------------------------------------------------------------------------------------------------*/
+static int32_t build_msg_hash(FIXMsgDescr const** msgs, uint32_t count, uint32_t bits, uint32_t seed, FIXProtocolDescr* prot)
+{
+   memset(prot->msg_index, 0, sizeof(FIXMsgDescr const*) << bits);
+   prot->msg_seed = seed;
+   prot->msg_shift = 32 - bits;
+   for(uint32_t i = 0; i < count; ++i)
+   {
+      uint32_t const idx = (msgs[i]->type_key * seed) >> prot->msg_shift;
+      if (prot->msg_index[idx])
+      {
+         return 0;
+      }
+      prot->msg_index[idx] = msgs[i];
+   }
+   return 1;
+}
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+static FIXErrCode build_msg_index(FIXProtocolDescr* prot, FIXError** error)
+{
+   uint32_t count = 0;
+   for(int32_t i = 0; i < MSG_CNT; ++i)
+   {
+      for(FIXMsgDescr const* msg = prot->messages[i]; msg; msg = msg->next)
+      {
+         ++count;
+      }
+   }
+   FIXMsgDescr const** msgs = (FIXMsgDescr const**)fix_utils_alloc(&prot->allocator, (count ? count : 1) * sizeof(FIXMsgDescr const*));
+   if (!msgs)
+   {
+      *error = fix_error_create(FIX_ERROR_MALLOC, "Unable to allocate message index.");
+      return FIX_FAILED;
+   }
+   count = 0;
+   for(int32_t i = 0; i < MSG_CNT; ++i)
+   {
+      for(FIXMsgDescr const* msg = prot->messages[i]; msg; msg = msg->next)
+      {
+         uint32_t j = 0;
+         while(j < count && msgs[j]->type_key != msg->type_key)
+         {
+            ++j;
+         }
+         if (msg->type_key && j == count) // if type is duplicated, first in hash chain wins like in chain lookup
+         {
+            msgs[count++] = msg;
+         }
+      }
+   }
+   // look for collision-free multiplier, growing the table if it's too crowded
+   uint32_t bits = 1;
+   while((1u << bits) < count * 2)
+   {
+      ++bits;
+   }
+   prot->msg_index = (FIXMsgDescr const**)fix_utils_alloc(&prot->allocator, sizeof(FIXMsgDescr const*) << bits);
+   uint32_t seed = 0x9E3779B1;
+   for(uint32_t attempt = 1; prot->msg_index && !build_msg_hash(msgs, count, bits, seed | 1, prot); ++attempt)
+   {
+      seed = seed * 1664525 + 1013904223;
+      if (attempt % 256 == 0)
+      {
+         ++bits;
+         fix_utils_free(&prot->allocator, prot->msg_index); // table is rebuilt from scratch, no need to keep content
+         prot->msg_index = (FIXMsgDescr const**)fix_utils_alloc(&prot->allocator, sizeof(FIXMsgDescr const*) << bits);
+      }
+   }
+   fix_utils_free(&prot->allocator, msgs);
+   if (!prot->msg_index)
+   {
+      *error = fix_error_create(FIX_ERROR_MALLOC, "Unable to allocate message index.");
+      return FIX_FAILED;
+   }
+   return FIX_SUCCESS;
+}
+
 /*-----------------------------------------------------------------------------------------------------------------------*/
 static int32_t load_transport_protocol(FIXProtocolDescr* prot, xmlNode* parentRoot, char const* parentFile, FIXError** error)
 {
@@ -380,7 +647,12 @@ static int32_t load_transport_protocol(FIXProtocolDescr* prot, xmlNode* parentRo
    char const* transpFile = get_attr(parentRoot, "transport", parentFile);
    if(!strcmp(transpFile, parentFile)) // transport is the same as protocol
    {
-      prot->transportVersion = _strdup(prot->version);
+      prot->transportVersion = fix_utils_strdup(&prot->allocator, prot->version);
+      if (!prot->transportVersion)
+      {
+         *error = fix_error_create(FIX_ERROR_MALLOC, "Unable to allocate transport version.");
+         goto err;
+      }
       goto ok;
    }
    char path[PATH_MAX] = {};
@@ -399,7 +671,12 @@ static int32_t load_transport_protocol(FIXProtocolDescr* prot, xmlNode* parentRo
       goto err;
    }
    xmlNode* root = xmlDocGetRootElement(doc);
-   prot->transportVersion = _strdup(get_attr(root, "version", NULL));
+   prot->transportVersion = fix_utils_strdup(&prot->allocator, get_attr(root, "version", NULL));
+   if (!prot->transportVersion)
+   {
+      *error = fix_error_create(FIX_ERROR_MALLOC, "Unable to allocate transport version.");
+      goto err;
+   }
    if (!strcmp(prot->version, prot->transportVersion)) // versions are the same, no need to process transport protocol
    {
       goto ok;
@@ -409,7 +686,7 @@ static int32_t load_transport_protocol(FIXProtocolDescr* prot, xmlNode* parentRo
       *error = fix_error_create(FIX_ERROR_PROTOCOL_XML_LOAD_FAILED, xmlGetLastError()->message);
       goto err;
    }
-   if (load_field_types(&prot->transport_field_types, root, error) == FIX_FAILED)
+   if (load_field_types(&prot->allocator, &prot->transport_field_types, root, error) == FIX_FAILED)
    {
       goto err;
    }
@@ -431,7 +708,7 @@ ok:
 /*-----------------------------------------------------------------------------------------------------------------------*/
 /* PUBLICS                                                                                                               */
 /*-----------------------------------------------------------------------------------------------------------------------*/
-FIXProtocolDescr const* fix_protocol_descr_create(char const* file, FIXError** error)
+FIXProtocolDescr const* fix_protocol_descr_create(char const* file, FIXAllocator const* allocator, FIXError** error)
 {
    FIXProtocolDescr* prot = NULL;
    initLibXml(error);
@@ -451,13 +728,28 @@ FIXProtocolDescr const* fix_protocol_descr_create(char const* file, FIXError** e
       *error = fix_error_create(FIX_ERROR_PROTOCOL_XML_LOAD_FAILED, xmlGetLastError()->message);
       goto err;
    }
-   prot = (FIXProtocolDescr*)calloc(1, sizeof(FIXProtocolDescr));
-   prot->version = _strdup(get_attr(root, "version", NULL));
-   if (prot && load_transport_protocol(prot, root, file, error) == FIX_FAILED)
+   prot = (FIXProtocolDescr*)fix_utils_alloc(allocator, sizeof(FIXProtocolDescr));
+   if (!prot)
+   {
+      *error = fix_error_create(FIX_ERROR_MALLOC, "Unable to allocate protocol description.");
+      goto err;
+   }
+   if (allocator)
+   {
+      prot->allocator = *allocator;
+   }
+   prot->refs = 1;
+   prot->version = fix_utils_strdup(&prot->allocator, get_attr(root, "version", NULL));
+   if (!prot->version)
    {
+      *error = fix_error_create(FIX_ERROR_MALLOC, "Unable to allocate protocol version.");
       goto err;
    }
-   else if (load_field_types(&prot->field_types, root, error) == FIX_FAILED)
+   else if (load_transport_protocol(prot, root, file, error) == FIX_FAILED)
+   {
+      goto err;
+   }
+   else if (load_field_types(&prot->allocator, &prot->field_types, root, error) == FIX_FAILED)
    {
       goto err;
    }
@@ -465,13 +757,16 @@ FIXProtocolDescr const* fix_protocol_descr_create(char const* file, FIXError** e
    {
       goto err;
    }
-   goto ok;
-err:
-   if (prot)
+   else if (build_msg_index(prot, error) == FIX_FAILED)
    {
-      free(prot);
-      prot = NULL;
+      goto err;
    }
+   // resolve SIMD dispatch now, before description is shared by parsing threads
+   fix_utils_get_simd_level();
+   goto ok;
+err:
+   fix_protocol_descr_free(prot); // releases everything loaded so far
+   prot = NULL;
 ok:
    if (doc)
    {
@@ -480,10 +775,17 @@ ok:
    return prot;
 }
 
+/*-----------------------------------------------------------------------------------------------------------------------*/
+FIXProtocolDescr const* fix_protocol_descr_ref(FIXProtocolDescr const* prot)
+{
+   ATOMIC_INC(&((FIXProtocolDescr*)prot)->refs);
+   return prot;
+}
+
 /*-----------------------------------------------------------------------------------------------------------------------*/
 void fix_protocol_descr_free(FIXProtocolDescr const* prot)
 {
-   if (!prot)
+   if (!prot || ATOMIC_DEC(&((FIXProtocolDescr*)prot)->refs) > 0)
    {
       return;
    }
@@ -493,7 +795,14 @@ void fix_protocol_descr_free(FIXProtocolDescr const* prot)
       while(ft)
       {
          FIXFieldType* next_ft = ft->next;
-         free_field_type(ft);
+         free_field_type(&prot->allocator, ft);
+         ft = next_ft;
+      }
+      ft = prot->transport_field_types[i];
+      while(ft)
+      {
+         FIXFieldType* next_ft = ft->next;
+         free_field_type(&prot->allocator, ft);
          ft = next_ft;
       }
    }
@@ -503,13 +812,15 @@ void fix_protocol_descr_free(FIXProtocolDescr const* prot)
       while(msg)
       {
          FIXMsgDescr* next_msg = msg->next;
-         free_message(msg);
+         free_message(&prot->allocator, msg);
          msg = next_msg;
       }
    }
-   free(prot->version);
-   free(prot->transportVersion);
-   free((void*)prot);
+   FIXAllocator const allocator = prot->allocator;
+   fix_utils_free(&allocator, prot->msg_index);
+   fix_utils_free(&allocator, prot->version);
+   fix_utils_free(&allocator, prot->transportVersion);
+   fix_utils_free(&allocator, (void*)prot);
 }
 
 
@@ -532,50 +843,65 @@ FIXFieldType* fix_protocol_get_field_type(FIXFieldType* (*ftypes)[FIELD_TYPE_CNT
 /*-----------------------------------------------------------------------------------------------------------------------*/
 FIXMsgDescr const* fix_protocol_get_msg_descr(FIXParser* parser, char const* type, FIXError** error)
 {
-   int32_t idx = fix_utils_hash_string(type, strlen(type)) % MSG_CNT;
-   FIXMsgDescr* msg = parser->protocol->messages[idx];
+   FIXMsgDescr const* msg = fix_protocol_find_msg_descr(parser->protocol, type, strlen(type));
+   if (!msg)
+   {
+      *error = fix_error_create(FIX_ERROR_UNKNOWN_MSG, "FIXMsgDescr with type '%s' not found", type);
+   }
+   return msg;
+}
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+FIXMsgDescr const* fix_protocol_find_msg_descr(FIXProtocolDescr const* prot, char const* type, uint32_t len)
+{
+   uint32_t const key = fix_protocol_pack_msg_type(type, len);
+   if (LIKE(key))
+   {
+      FIXMsgDescr const* msg = prot->msg_index[(key * prot->msg_seed) >> prot->msg_shift];
+      return (msg && msg->type_key == key) ? msg : NULL;
+   }
+   FIXMsgDescr const* msg = prot->messages[fix_utils_hash_string(type, len) % MSG_CNT];
    while(msg)
    {
-      if (!strcmp(msg->type, type))
+      if (!strncmp(msg->type, type, len) && !msg->type[len])
       {
          return msg;
       }
       msg = msg->next;
    }
-   *error = fix_error_create(FIX_ERROR_UNKNOWN_MSG, "FIXMsgDescr with type '%s' not found", type);
    return NULL;
 }
 
 //------------------------------------------------------------------------------------------------------------------------//
-FIXFieldDescr const* fix_protocol_get_field_descr(FIXMsgDescr const* msg, FIXTagNum tag)
+static inline FIXFieldDescr const* get_indexed_descr(FIXTagIndex const* index, FIXFieldDescr const* fields, FIXTagNum tag)
 {
-   int32_t idx = tag % FIELD_DESCR_CNT;
-   FIXFieldDescr const* fld = msg->field_index[idx];
-   while(fld)
+   uint32_t const off = (uint32_t)(tag - index->dense_min);
+   if (off < index->dense_size)
    {
-      if (fld->type->tag == tag)
+      uint16_t const pos = index->dense[off];
+      return pos ? &fields[pos - 1] : NULL;
+   }
+   if (index->hash)
+   {
+      uint16_t const pos = index->hash[((uint32_t)tag * index->hash_seed) >> index->hash_shift];
+      if (pos && fields[pos - 1].type->tag == tag)
       {
-         return fld;
+         return &fields[pos - 1];
       }
-      fld = fld->next;
    }
-   return 0;
+   return NULL;
+}
+
+//------------------------------------------------------------------------------------------------------------------------//
+FIXFieldDescr const* fix_protocol_get_field_descr(FIXMsgDescr const* msg, FIXTagNum tag)
+{
+   return get_indexed_descr(&msg->field_index, msg->fields, tag);
 }
 
 /*-----------------------------------------------------------------------------------------------------------------------*/
 FIXFieldDescr const* fix_protocol_get_group_descr(FIXFieldDescr const* field, FIXTagNum tag)
 {
-   int32_t idx = tag % FIELD_DESCR_CNT;
-   FIXFieldDescr const* fld = field->group_index[idx];
-   while(fld)
-   {
-      if (fld->type->tag == tag)
-      {
-         return fld;
-      }
-      fld = fld->next;
-   }
-   return NULL;
+   return get_indexed_descr(&field->group_index, field->group, tag);
 }
 
 /*------------------------------------------------------------------------------------------------------------------------*/
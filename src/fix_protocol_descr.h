@@ -21,9 +21,16 @@ extern "C"
 
 #define FIELD_VALUE_CNT 32
 #define FIELD_TYPE_CNT 1024
-#define FIELD_DESCR_CNT 128
 #define MSG_CNT 128
 #define FIELD_FLAG_REQUIRED 0x01
+#define FIELD_DENSE_TAG_LIMIT 4096 ///< tags below this limit are indexed by dense array, others by perfect hash
+#define MSG_TYPE_KEY_LEN 3         ///< message types up to this length are packed into uint32 key
+#define FIELD_PREFIX_LEN 12        ///< enough for "tag=" prefix of any tag
+
+#define FIELD_EMIT_VALUE       0   ///< field value is copied as is
+#define FIELD_EMIT_GROUP       1   ///< repeating group, which is serialized by plan of group fields
+#define FIELD_EMIT_BODY_LENGTH 2   ///< BodyLength, which is calculated by message
+#define FIELD_EMIT_CHECKSUM    3   ///< CheckSum, which is calculated by serialized data
 
 /**
  * FIX field possible value
@@ -46,6 +53,20 @@ typedef struct FIXFieldType_
    struct FIXFieldType_* next;      ///< next type in chain
 } FIXFieldType;
 
+/**
+ * collision-free index of field descriptions by tag. Values are positions in array of field descriptions plus one,
+ * zero means no such tag
+ */
+typedef struct FIXTagIndex_
+{
+   FIXTagNum dense_min;             ///< lowest tag in dense array
+   uint32_t dense_size;             ///< size of dense array
+   uint16_t* dense;                 ///< dense array for tags [dense_min, dense_min + dense_size)
+   uint32_t hash_seed;              ///< multiplier of perfect hash function
+   uint32_t hash_shift;             ///< hash function is (tag * hash_seed) >> hash_shift
+   uint16_t* hash;                  ///< perfect hash table for tags >= FIELD_DENSE_TAG_LIMIT, NULL if no such tags
+} FIXTagIndex;
+
 /**
  * descrion of FIX field
  */
@@ -54,11 +75,14 @@ typedef struct FIXFieldDescr_
    FIXFieldType* type;                  ///< type of FIX field
    FIXFieldCategoryEnum category;       ///< category - value or group
    uint8_t flags;                       ///< only FIELD_FLAG_REQUIRED is used
+   uint32_t ordinal;                    ///< slot of field in message/group, duplicated tags share the same slot
    uint32_t group_count;                ///< count of field descriptions in group
    struct FIXFieldDescr_*  group;       ///< all field descriptions indexed as array
-   struct FIXFieldDescr_** group_index; ///< hash table with field descriptions
-   struct FIXFieldDescr_*  next;        ///< next field description in hash table
+   FIXTagIndex group_index;             ///< index of group field descriptions by tag
    struct FIXFieldDescr_*  dataLenField; ///< reference to field description. Not NULL if this field has valueType == Data.
+   uint8_t emit;                        ///< serialization routine of field, see FIELD_EMIT_* values
+   uint8_t prefix_len;                  ///< length of prefix
+   char prefix[FIELD_PREFIX_LEN];       ///< pre-rendered "tag=" prefix of serialized field
 } FIXFieldDescr;
 
 /**
@@ -67,35 +91,52 @@ typedef struct FIXFieldDescr_
 typedef struct FIXMsgDescr_
 {
    char* type;                   ///< type. E.g. "A", "AE", "D"
+   uint32_t id;                  ///< dense number of message in protocol, [0, FIXProtocolDescr::msg_count)
+   uint32_t type_key;            ///< type packed by fix_protocol_pack_msg_type, 0 - type is too long for packing
    char* name;                   ///< textual message name
    uint32_t field_count;         ///< count of field descriptions
-   FIXFieldDescr* fields;        ///< all fields indexed as array
-   FIXFieldDescr** field_index;  ///< hash table with fields
+   FIXFieldDescr* fields;        ///< all fields indexed as array. In protocol order, so it is serialization plan of message
+   FIXTagIndex field_index;      ///< index of fields by tag
    struct FIXMsgDescr_* next;    ///< next description with the same hash key
 } FIXMsgDescr;
 
 /**
- * FIX protocol description
+ * FIX protocol description. Immutable after creation, so it can be shared by parsers running in different threads
  */
-typedef struct FIXProtocolDescr_
+struct FIXProtocolDescr_
 {
    char* version;                                        ///< protocol version ("FIX.4.4", "FIX.5.0", etc)
    char* transportVersion;                               ///< version of transport protocol. If protocol doesn't have a transport transportVersion == version
    FIXFieldType* field_types[FIELD_TYPE_CNT];            ///< array of field types
    FIXFieldType* transport_field_types[FIELD_TYPE_CNT];  ///< field types of transport protocol
    FIXMsgDescr* messages[MSG_CNT];                       ///< message descriptions (transport and application levels)
-} FIXProtocolDescr;
+   uint32_t msg_count;                                   ///< count of message descriptions
+   uint32_t msg_seed;                                    ///< multiplier of perfect hash function of message types
+   uint32_t msg_shift;                                   ///< hash function is (type_key * msg_seed) >> msg_shift
+   FIXMsgDescr const** msg_index;                        ///< perfect hash table of messages by type_key
+   volatile int32_t refs;                                ///< count of references. Description is destroyed, when it drops to zero
+   FIXAllocator allocator;                               ///< allocator of description memory
+};
 
 /**
  * parse protocol xml file and create protocol description
  * @param[in] file - protocol xml file
+ * @param[in] allocator - allocator of description memory, NULL - calloc/free
  * @param[out] error - in case of parse error, this error is set
+ * @return protocol description with one reference
+ */
+FIXProtocolDescr const* fix_protocol_descr_create(char const* file, FIXAllocator const* allocator, FIXError** error);
+
+/**
+ * add reference to protocol description
+ * @param[in] prot - referenced protocol
+ * @return prot
  */
-FIXProtocolDescr const* fix_protocol_descr_create(char const* file, FIXError** error);
+FIXProtocolDescr const* fix_protocol_descr_ref(FIXProtocolDescr const* prot);
 
 /**
- * destroy protocol description
- * @param[in] prot - protocol, which is being deleted
+ * release reference to protocol description. Description is destroyed, when last reference is released
+ * @param[in] prot - protocol, which is being released
  */
 void fix_protocol_descr_free(FIXProtocolDescr const* prot);
 
@@ -116,6 +157,34 @@ FIXFieldType* fix_protocol_get_field_type(FIXFieldType* (*ftypes)[FIELD_TYPE_CNT
  */
 FIXMsgDescr const* fix_protocol_get_msg_descr(FIXParser* parser, char const* type, FIXError** error);
 
+/**
+ * find FIX message description by type without any allocation
+ * @param[in] prot - FIX protocol description
+ * @param[in] type - FIX message type, not necessary null-terminated
+ * @param[in] len - length of type
+ * @return FIX message description, NULL - not found
+ */
+FIXMsgDescr const* fix_protocol_find_msg_descr(FIXProtocolDescr const* prot, char const* type, uint32_t len);
+
+/**
+ * pack short FIX message type into numeric key
+ * @param[in] type - FIX message type, not necessary null-terminated
+ * @param[in] len - length of type
+ * @return packed type, 0 - type is empty or longer than MSG_TYPE_KEY_LEN
+ */
+static inline uint32_t fix_protocol_pack_msg_type(char const* type, uint32_t len)
+{
+   uint32_t key = 0;
+   if (len && len <= MSG_TYPE_KEY_LEN)
+   {
+      for(uint32_t i = 0; i < len; ++i)
+      {
+         key |= (uint32_t)(unsigned char)type[i] << (i * 8);
+      }
+   }
+   return key;
+}
+
 /**
  * get FIX field description by tag number
  * @param[in] msg - FIX message description
@@ -0,0 +1,354 @@
+/**
+ * @file   fix_template.c
+ * @date   Created on: 10/17/2026 04:20:12 PM
+ */
+
+#include "fix_template.h"
+#include "fix_msg.h"
+#include "fix_msg_priv.h"
+#include "fix_field.h"
+#include "fix_parser_priv.h"
+#include "fix_protocol_descr.h"
+#include "fix_utils.h"
+#include "fix_error_priv.h"
+
+#include <string.h>
+
+#define MAX_BODY_LEN_DIGITS 10 ///< header is shifted left, when BodyLength grows, so this room is reserved before it
+#define BUFF_RESERVE 64        ///< room for growing values of variable-width slots
+
+/**
+ * patchable value of template
+ */
+typedef struct FIXTemplatePatch_
+{
+   FIXTagNum tag;             ///< field tag
+   uint32_t width;            ///< fixed width of value, 0 - variable width
+   uint32_t offset;           ///< offset of value in template buffer
+   uint32_t len;              ///< current length of value
+} FIXTemplatePatch;
+
+/**
+ * pre-rendered FIX message. Message is buff[begin, end), header "8=...|9=" is prefix_len bytes long, body (counted
+ * by BodyLength) is buff[body, checksum)
+ */
+struct FIXTemplate_
+{
+   FIXAllocator allocator;    ///< allocator of template memory, copy of parser one
+   char delimiter;            ///< FIX SOH
+   char* buff;                ///< template buffer
+   uint32_t size;             ///< size of template buffer
+   uint32_t begin;            ///< offset of BeginString
+   uint32_t prefix_len;       ///< length of "8=...|9=" prefix
+   uint32_t body;             ///< offset of body
+   uint32_t checksum;         ///< offset of CheckSum field, i.e. end of body
+   uint32_t body_sum;         ///< sum of body bytes modulo 256
+   int32_t dirty;             ///< BodyLength and CheckSum must be rewritten
+   uint32_t slot_count;       ///< count of slots
+   FIXTemplatePatch slots[1]; ///< slots, actually slot_count items
+};
+
+static FIXErrCode fix_template_init(FIXTemplate* tmpl, FIXMsg* msg, FIXTemplateSlot const* slots, FIXError** error);
+static FIXErrCode fix_template_patch(
+      FIXTemplate* tmpl, FIXTemplatePatch* slot, char const* val, uint32_t len, FIXError** error);
+static FIXErrCode fix_template_set_number(
+      FIXTemplate* tmpl, uint32_t slot, char const* val, uint32_t len, FIXError** error);
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+/* PUBLICS                                                                                                                */
+/*------------------------------------------------------------------------------------------------------------------------*/
+FIX_PARSER_API FIXTemplate* fix_template_create(FIXMsg* msg, char delimiter, FIXTemplateSlot const* slots,
+      uint32_t slotCount, FIXError** error)
+{
+   if (!msg || (slotCount && !slots))
+   {
+      *error = fix_error_create(FIX_ERROR_INVALID_ARGUMENT, "Message or slots are NULL");
+      return NULL;
+   }
+   FIXAllocator const* allocator = &msg->parser->attrs.allocator;
+   FIXTemplate* tmpl = (FIXTemplate*)fix_utils_alloc(allocator,
+         sizeof(FIXTemplate) + (slotCount ? slotCount - 1 : 0) * sizeof(FIXTemplatePatch));
+   if (!tmpl)
+   {
+      *error = fix_error_create(FIX_ERROR_MALLOC, "Unable to allocate template");
+      return NULL;
+   }
+   tmpl->allocator = *allocator;
+   tmpl->delimiter = delimiter;
+   tmpl->slot_count = slotCount;
+   if (fix_template_init(tmpl, msg, slots, error) == FIX_FAILED)
+   {
+      fix_template_free(tmpl);
+      return NULL;
+   }
+   return tmpl;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+FIX_PARSER_API void fix_template_free(FIXTemplate* tmpl)
+{
+   if (!tmpl)
+   {
+      return;
+   }
+   FIXAllocator const allocator = tmpl->allocator;
+   fix_utils_free(&allocator, tmpl->buff);
+   fix_utils_free(&allocator, tmpl);
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+FIX_PARSER_API FIXErrCode fix_template_set_string(FIXTemplate* tmpl, uint32_t slot, char const* val, uint32_t len,
+      FIXError** error)
+{
+   if (!tmpl || !val)
+   {
+      return FIX_FAILED;
+   }
+   if (slot >= tmpl->slot_count)
+   {
+      *error = fix_error_create(FIX_ERROR_INVALID_ARGUMENT, "Slot %u is out of range", slot);
+      return FIX_FAILED;
+   }
+   FIXTemplatePatch* patch = &tmpl->slots[slot];
+   if (!len || fix_utils_find_char(val, len, tmpl->delimiter)) // value would break message framing
+   {
+      *error = fix_error_create(FIX_ERROR_WRONG_FIELD_VALUE, "Tag %d value is empty or contains delimiter", patch->tag);
+      return FIX_FAILED;
+   }
+   if (patch->width && len != patch->width)
+   {
+      *error = fix_error_create(FIX_ERROR_WRONG_FIELD_VALUE, "Tag %d value length %u differs from slot width %u",
+            patch->tag, len, patch->width);
+      return FIX_FAILED;
+   }
+   return fix_template_patch(tmpl, patch, val, len, error);
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+FIX_PARSER_API FIXErrCode fix_template_set_int64(FIXTemplate* tmpl, uint32_t slot, int64_t val, FIXError** error)
+{
+   char buff[32];
+   int32_t const len = fix_utils_i64toa(val, buff, sizeof(buff), 0);
+   return fix_template_set_number(tmpl, slot, buff, len, error);
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+FIX_PARSER_API FIXErrCode fix_template_set_decimal(FIXTemplate* tmpl, uint32_t slot, int64_t mantissa, int32_t exponent,
+      FIXError** error)
+{
+   char buff[FIX_DECTOA_BUFF_LEN];
+   int32_t const len = fix_utils_dectoa(mantissa, exponent, buff, sizeof(buff));
+   if (!len)
+   {
+      *error = fix_error_create(FIX_ERROR_INVALID_ARGUMENT, "Exponent %d is out of range [-%d, %d]", exponent,
+            FIX_DEC_MAX_EXPONENT, FIX_DEC_MAX_EXPONENT);
+      return FIX_FAILED;
+   }
+   return fix_template_set_number(tmpl, slot, buff, len, error);
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+FIX_PARSER_API FIXErrCode fix_template_get_data(FIXTemplate* tmpl, char const** data, uint32_t* len)
+{
+   if (!tmpl || !data || !len)
+   {
+      return FIX_FAILED;
+   }
+   if (tmpl->dirty)
+   {
+      // BodyLength is written right before body, so header is moved, if count of its digits is changed
+      uint32_t const bodyLen = tmpl->checksum - tmpl->body;
+      uint32_t const digits = fix_utils_numdigits(bodyLen);
+      uint32_t const begin = tmpl->body - 1 - digits - tmpl->prefix_len;
+      if (begin != tmpl->begin)
+      {
+         memmove(tmpl->buff + begin, tmpl->buff + tmpl->begin, tmpl->prefix_len);
+         tmpl->begin = begin;
+      }
+      fix_utils_i64toa(bodyLen, tmpl->buff + tmpl->body - 1 - digits, digits, 0);
+      uint32_t const sum = fix_utils_checksum(tmpl->buff + begin, tmpl->body - begin) + tmpl->body_sum;
+      fix_utils_i64toa(sum & 0xFF, tmpl->buff + tmpl->checksum + 3, 3, '0');
+      tmpl->dirty = 0;
+   }
+   *data = tmpl->buff + tmpl->begin;
+   *len = tmpl->checksum + 7 - tmpl->begin;
+   return FIX_SUCCESS;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+/* PRIVATES                                                                                                               */
+/*------------------------------------------------------------------------------------------------------------------------*/
+static FIXErrCode fix_template_init(FIXTemplate* tmpl, FIXMsg* msg, FIXTemplateSlot const* slots, FIXError** error)
+{
+   FIXMsgDescr const* descr = msg->descr;
+   for(uint32_t i = 0; i < tmpl->slot_count; ++i)
+   {
+      FIXFieldDescr const* fdescr = fix_protocol_get_field_descr(descr, slots[i].tag);
+      if (!fdescr)
+      {
+         *error = fix_error_create(FIX_ERROR_UNKNOWN_FIELD, "Tag %d is not a field of message '%s'", slots[i].tag,
+               descr->type);
+         return FIX_FAILED;
+      }
+      if (fdescr->emit != FIELD_EMIT_VALUE || fdescr->type->tag == FIXFieldTag_BeginString ||
+          fdescr->type->valueType == FIXFieldValueType_Length || IS_DATA_TYPE(fdescr->type->valueType))
+      {
+         *error = fix_error_create(FIX_ERROR_FIELD_HAS_WRONG_TYPE, "Tag %d can't be patched", slots[i].tag);
+         return FIX_FAILED;
+      }
+      for(uint32_t j = 0; j < descr->field_count; ++j)
+      {
+         if (&descr->fields[j] != fdescr && descr->fields[j].ordinal == fdescr->ordinal)
+         {
+            *error = fix_error_create(FIX_ERROR_FIELD_HAS_WRONG_TYPE, "Tag %d is repeated in message", slots[i].tag);
+            return FIX_FAILED;
+         }
+      }
+      for(uint32_t j = 0; j < i; ++j)
+      {
+         if (slots[j].tag == slots[i].tag)
+         {
+            *error = fix_error_create(FIX_ERROR_INVALID_ARGUMENT, "Tag %d has several slots", slots[i].tag);
+            return FIX_FAILED;
+         }
+      }
+   }
+   uint32_t msgLen = 0;
+   if (fix_msg_to_str(msg, tmpl->delimiter, NULL, 0, &msgLen, error) != FIX_ERROR_NO_MORE_SPACE)
+   {
+      *error = fix_error_create(FIX_ERROR_INVALID_ARGUMENT, "Message can't be serialized");
+      return FIX_FAILED;
+   }
+   uint32_t const headroom = MAX_BODY_LEN_DIGITS - fix_utils_numdigits(msg->body_len);
+   tmpl->size = headroom + msgLen + BUFF_RESERVE;
+   tmpl->buff = (char*)fix_utils_alloc(&tmpl->allocator, tmpl->size);
+   uint32_t* offsets = (uint32_t*)fix_utils_alloc(&tmpl->allocator, descr->field_count * sizeof(uint32_t));
+   FIXErrCode res = FIX_FAILED;
+   if (!tmpl->buff || !offsets)
+   {
+      *error = fix_error_create(FIX_ERROR_MALLOC, "Unable to allocate template buffer");
+      goto err;
+   }
+   char* msgData = tmpl->buff + headroom;
+   if (fix_msg_fields_to_str(msg, tmpl->delimiter, msgData, msgData + msgLen, offsets, error) == FIX_FAILED)
+   {
+      goto err;
+   }
+   char const* prefixEnd = msgLen > 4 ? fix_utils_find_char(msgData, msgLen, tmpl->delimiter) : NULL;
+   char const* bodyLenEnd = prefixEnd ? fix_utils_find_char(prefixEnd + 1, msgLen - (prefixEnd + 1 - msgData),
+         tmpl->delimiter) : NULL;
+   if (strncmp(msgData, "8=", 2) || !bodyLenEnd || strncmp(prefixEnd + 1, "9=", 2) ||
+       strncmp(msgData + msgLen - 7, "10=", 3) || msgData[msgLen - 1] != tmpl->delimiter)
+   {
+      *error = fix_error_create(FIX_ERROR_INTEGRITY_CHECK, "Message has no BeginString, BodyLength or CheckSum");
+      goto err;
+   }
+   tmpl->begin = headroom;
+   tmpl->prefix_len = prefixEnd + 3 - msgData;
+   tmpl->body = bodyLenEnd + 1 - tmpl->buff;
+   tmpl->checksum = headroom + msgLen - 7;
+   tmpl->body_sum = fix_utils_checksum(tmpl->buff + tmpl->body, tmpl->checksum - tmpl->body);
+   tmpl->dirty = 1; // BodyLength and CheckSum are rewritten from actual body
+   for(uint32_t i = 0; i < tmpl->slot_count; ++i)
+   {
+      FIXFieldDescr const* fdescr = fix_protocol_get_field_descr(descr, slots[i].tag);
+      uint32_t const offset = offsets[fdescr - descr->fields];
+      if (offset == UINT32_MAX)
+      {
+         *error = fix_error_create(FIX_ERROR_FIELD_NOT_FOUND, "Tag %d is not set in message", slots[i].tag);
+         goto err;
+      }
+      FIXTemplatePatch* patch = &tmpl->slots[i];
+      patch->tag = slots[i].tag;
+      patch->width = slots[i].width;
+      patch->offset = headroom + offset;
+      patch->len = fix_field_get_by_descr(msg, NULL, fdescr)->size;
+      if (patch->width && patch->len != patch->width)
+      {
+         *error = fix_error_create(FIX_ERROR_WRONG_FIELD_VALUE, "Tag %d value length %u differs from slot width %u",
+               patch->tag, patch->len, patch->width);
+         goto err;
+      }
+   }
+   res = FIX_SUCCESS;
+err:
+   fix_utils_free(&tmpl->allocator, offsets);
+   return res;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+static FIXErrCode fix_template_patch(
+      FIXTemplate* tmpl, FIXTemplatePatch* slot, char const* val, uint32_t len, FIXError** error)
+{
+   uint32_t const oldSum = fix_utils_checksum(tmpl->buff + slot->offset, slot->len);
+   if (len != slot->len)
+   {
+      uint32_t const end = tmpl->checksum + 7;
+      uint32_t const need = end - slot->len + len;
+      if (need > tmpl->size)
+      {
+         uint32_t const size = need > tmpl->size * 2 ? need : tmpl->size * 2;
+         char* buff = (char*)fix_utils_alloc(&tmpl->allocator, size);
+         if (!buff)
+         {
+            *error = fix_error_create(FIX_ERROR_MALLOC, "Unable to grow template buffer");
+            return FIX_FAILED;
+         }
+         memcpy(buff, tmpl->buff, end);
+         fix_utils_free(&tmpl->allocator, tmpl->buff);
+         tmpl->buff = buff;
+         tmpl->size = size;
+      }
+      char* tail = tmpl->buff + slot->offset + slot->len;
+      memmove(tail + len - slot->len, tail, tmpl->buff + end - tail);
+      for(uint32_t i = 0; i < tmpl->slot_count; ++i)
+      {
+         if (tmpl->slots[i].offset > slot->offset)
+         {
+            tmpl->slots[i].offset += len - slot->len;
+         }
+      }
+      tmpl->checksum += len - slot->len;
+      slot->len = len;
+   }
+   memcpy(tmpl->buff + slot->offset, val, len);
+   tmpl->body_sum += fix_utils_checksum(val, len) - oldSum; // modulo 256 is taken when CheckSum is written
+   tmpl->dirty = 1;
+   return FIX_SUCCESS;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+static FIXErrCode fix_template_set_number(
+      FIXTemplate* tmpl, uint32_t slot, char const* val, uint32_t len, FIXError** error)
+{
+   if (!tmpl)
+   {
+      return FIX_FAILED;
+   }
+   if (slot >= tmpl->slot_count)
+   {
+      *error = fix_error_create(FIX_ERROR_INVALID_ARGUMENT, "Slot %u is out of range", slot);
+      return FIX_FAILED;
+   }
+   FIXTemplatePatch* patch = &tmpl->slots[slot];
+   if (!patch->width || len == patch->width)
+   {
+      return fix_template_patch(tmpl, patch, val, len, error);
+   }
+   if (len > patch->width)
+   {
+      *error = fix_error_create(FIX_ERROR_WRONG_FIELD_VALUE, "Tag %d value '%.*s' is wider than slot width %u",
+            patch->tag, len, val, patch->width);
+      return FIX_FAILED;
+   }
+   // zeros are put between sign and digits, so value keeps slot width
+   char* value = tmpl->buff + patch->offset;
+   uint32_t const oldSum = fix_utils_checksum(value, patch->width);
+   uint32_t const sign = (val[0] == '-');
+   value[0] = '-';
+   memset(value + sign, '0', patch->width - len);
+   memcpy(value + sign + patch->width - len, val + sign, len - sign);
+   tmpl->body_sum += fix_utils_checksum(value, patch->width) - oldSum;
+   tmpl->dirty = 1;
+   return FIX_SUCCESS;
+}
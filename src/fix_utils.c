@@ -11,8 +11,384 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <errno.h>
+#ifdef WIN32
+#  include <windows.h>
+#else
+#  include <sys/mman.h>
+#  include <sys/syscall.h>
+#  include <unistd.h>
+#endif
 
-#define DOUBLE_MAX_DIGITS 15
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#  define FIX_UTILS_X86
+#  include <immintrin.h>
+#endif
+
+#define UINT64_MAX_DIGITS 20
+#define OS_PAGE_SIZE 4096
+#define HUGE_PAGE_SIZE (2 * 1024 * 1024)
+#define NUMA_MAX_NODE 63 ///< nodes are passed to mbind by one-word mask
+#define NUMA_MPOL_BIND 2 ///< MPOL_BIND from linux/mempolicy.h, numaif.h is not required
+
+typedef char const* (*find_char_func)(char const* buff, uint32_t buffLen, char ch);
+typedef uint32_t (*checksum_func)(char const* buff, uint32_t buffLen);
+
+static char const* find_char_resolve(char const* buff, uint32_t buffLen, char ch);
+static uint32_t checksum_resolve(char const* buff, uint32_t buffLen);
+
+static find_char_func find_char_impl = &find_char_resolve;
+
+static uint64_t const upow10[UINT64_MAX_DIGITS] =
+{
+   1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull, 10000000ull, 100000000ull, 1000000000ull,
+   10000000000ull, 100000000000ull, 1000000000000ull, 10000000000000ull, 100000000000000ull, 1000000000000000ull,
+   10000000000000000ull, 100000000000000000ull, 1000000000000000000ull, 10000000000000000000ull
+};
+
+static char const digit_pairs[201] =
+   "00010203040506070809"
+   "10111213141516171819"
+   "20212223242526272829"
+   "30313233343536373839"
+   "40414243444546474849"
+   "50515253545556575859"
+   "60616263646566676869"
+   "70717273747576777879"
+   "80818283848586878889"
+   "90919293949596979899";
+
+/* count of decimal digits. Bit length gives log10 estimate (1233/4096 ~ log10(2)), which is corrected by one compare */
+static inline uint32_t fix_utils_udigits(uint64_t val)
+{
+   uint64_t const v = val | 1;
+   uint32_t const t = ((64 - CLZ64(v)) * 1233) >> 12;
+   return t + 1 - (v < upow10[t]);
+}
+
+/* write digits of val, ending at end. Two digits are taken per step from digit_pairs */
+static inline void utoa_backward(uint64_t val, char* end)
+{
+   while(val >= 100)
+   {
+      uint32_t const pair = (uint32_t)(val % 100) * 2;
+      val /= 100;
+      end -= 2;
+      end[0] = digit_pairs[pair];
+      end[1] = digit_pairs[pair + 1];
+   }
+   if (val >= 10)
+   {
+      end[-2] = digit_pairs[val * 2];
+      end[-1] = digit_pairs[val * 2 + 1];
+   }
+   else
+   {
+      end[-1] = '0' + (char)val;
+   }
+}
+
+/* extended precision float f * 2^e, used by Grisu */
+typedef struct DiyFp_
+{
+   uint64_t f;
+   int32_t e;
+} DiyFp;
+
+/* normalized 10^k for k = -348, -340, ..., 340 */
+static DiyFp const cached_pow10[] =
+{
+   {0xfa8fd5a0081c0288ull, -1220}, {0xbaaee17fa23ebf76ull, -1193}, {0x8b16fb203055ac76ull, -1166},
+   {0xcf42894a5dce35eaull, -1140}, {0x9a6bb0aa55653b2dull, -1113}, {0xe61acf033d1a45dfull, -1087},
+   {0xab70fe17c79ac6caull, -1060}, {0xff77b1fcbebcdc4full, -1034}, {0xbe5691ef416bd60cull, -1007},
+   {0x8dd01fad907ffc3cull, -980}, {0xd3515c2831559a83ull, -954}, {0x9d71ac8fada6c9b5ull, -927},
+   {0xea9c227723ee8bcbull, -901}, {0xaecc49914078536dull, -874}, {0x823c12795db6ce57ull, -847},
+   {0xc21094364dfb5637ull, -821}, {0x9096ea6f3848984full, -794}, {0xd77485cb25823ac7ull, -768},
+   {0xa086cfcd97bf97f4ull, -741}, {0xef340a98172aace5ull, -715}, {0xb23867fb2a35b28eull, -688},
+   {0x84c8d4dfd2c63f3bull, -661}, {0xc5dd44271ad3cdbaull, -635}, {0x936b9fcebb25c996ull, -608},
+   {0xdbac6c247d62a584ull, -582}, {0xa3ab66580d5fdaf6ull, -555}, {0xf3e2f893dec3f126ull, -529},
+   {0xb5b5ada8aaff80b8ull, -502}, {0x87625f056c7c4a8bull, -475}, {0xc9bcff6034c13053ull, -449},
+   {0x964e858c91ba2655ull, -422}, {0xdff9772470297ebdull, -396}, {0xa6dfbd9fb8e5b88full, -369},
+   {0xf8a95fcf88747d94ull, -343}, {0xb94470938fa89bcfull, -316}, {0x8a08f0f8bf0f156bull, -289},
+   {0xcdb02555653131b6ull, -263}, {0x993fe2c6d07b7facull, -236}, {0xe45c10c42a2b3b06ull, -210},
+   {0xaa242499697392d3ull, -183}, {0xfd87b5f28300ca0eull, -157}, {0xbce5086492111aebull, -130},
+   {0x8cbccc096f5088ccull, -103}, {0xd1b71758e219652cull, -77}, {0x9c40000000000000ull, -50},
+   {0xe8d4a51000000000ull, -24}, {0xad78ebc5ac620000ull, 3}, {0x813f3978f8940984ull, 30},
+   {0xc097ce7bc90715b3ull, 56}, {0x8f7e32ce7bea5c70ull, 83}, {0xd5d238a4abe98068ull, 109},
+   {0x9f4f2726179a2245ull, 136}, {0xed63a231d4c4fb27ull, 162}, {0xb0de65388cc8ada8ull, 189},
+   {0x83c7088e1aab65dbull, 216}, {0xc45d1df942711d9aull, 242}, {0x924d692ca61be758ull, 269},
+   {0xda01ee641a708deaull, 295}, {0xa26da3999aef774aull, 322}, {0xf209787bb47d6b85ull, 348},
+   {0xb454e4a179dd1877ull, 375}, {0x865b86925b9bc5c2ull, 402}, {0xc83553c5c8965d3dull, 428},
+   {0x952ab45cfa97a0b3ull, 455}, {0xde469fbd99a05fe3ull, 481}, {0xa59bc234db398c25ull, 508},
+   {0xf6c69a72a3989f5cull, 534}, {0xb7dcbf5354e9beceull, 561}, {0x88fcf317f22241e2ull, 588},
+   {0xcc20ce9bd35c78a5ull, 614}, {0x98165af37b2153dfull, 641}, {0xe2a0b5dc971f303aull, 667},
+   {0xa8d9d1535ce3b396ull, 694}, {0xfb9b7cd9a4a7443cull, 720}, {0xbb764c4ca7a44410ull, 747},
+   {0x8bab8eefb6409c1aull, 774}, {0xd01fef10a657842cull, 800}, {0x9b10a4e5e9913129ull, 827},
+   {0xe7109bfba19c0c9dull, 853}, {0xac2820d9623bf429ull, 880}, {0x80444b5e7aa7cf85ull, 907},
+   {0xbf21e44003acdd2dull, 933}, {0x8e679c2f5e44ff8full, 960}, {0xd433179d9c8cb841ull, 986},
+   {0x9e19db92b4e31ba9ull, 1013}, {0xeb96bf6ebadf77d9ull, 1039}, {0xaf87023b9bf0ee6bull, 1066},
+};
+
+static inline DiyFp diyfp_mul(DiyFp a, DiyFp b)
+{
+   uint64_t const M32 = 0xFFFFFFFFu;
+   uint64_t const ah = a.f >> 32, al = a.f & M32, bh = b.f >> 32, bl = b.f & M32;
+   uint64_t const hh = ah * bh, hl = ah * bl, lh = al * bh, ll = al * bl;
+   uint64_t const mid = (ll >> 32) + (hl & M32) + (lh & M32) + (1u << 31); // round lower half
+   DiyFp const res = {hh + (hl >> 32) + (lh >> 32) + (mid >> 32), a.e + b.e + 64};
+   return res;
+}
+
+/* move last digit towards w, while it stays inside of rounding interval */
+static inline void grisu_round(char* digits, int32_t len, uint64_t delta, uint64_t rest, uint64_t tenKappa, uint64_t wpw)
+{
+   while(rest < wpw && delta - rest >= tenKappa && (rest + tenKappa < wpw || wpw - rest > rest + tenKappa - wpw))
+   {
+      --digits[len - 1];
+      rest += tenKappa;
+   }
+}
+
+static int32_t grisu_digits(DiyFp w, DiyFp wp, uint64_t delta, char* digits, int32_t* K)
+{
+   DiyFp const one = {1ull << -wp.e, wp.e};
+   uint64_t const wpw = wp.f - w.f;
+   uint32_t p1 = (uint32_t)(wp.f >> -one.e);
+   uint64_t p2 = wp.f & (one.f - 1);
+   int32_t kappa = fix_utils_udigits(p1);
+   int32_t len = 0;
+   while(kappa > 0)
+   {
+      uint32_t const pow = (uint32_t)upow10[kappa - 1];
+      uint32_t const d = p1 / pow;
+      p1 %= pow;
+      if (d || len)
+      {
+         digits[len++] = '0' + (char)d;
+      }
+      --kappa;
+      uint64_t const rest = ((uint64_t)p1 << -one.e) + p2;
+      if (rest <= delta)
+      {
+         *K += kappa;
+         grisu_round(digits, len, delta, rest, upow10[kappa] << -one.e, wpw);
+         return len;
+      }
+   }
+   for(;;)
+   {
+      p2 *= 10;
+      delta *= 10;
+      char const d = (char)(p2 >> -one.e);
+      if (d || len)
+      {
+         digits[len++] = '0' + d;
+      }
+      p2 &= one.f - 1;
+      --kappa;
+      if (p2 < delta)
+      {
+         *K += kappa;
+         grisu_round(digits, len, delta, p2, one.f, wpw * (-kappa < UINT64_MAX_DIGITS ? upow10[-kappa] : 0));
+         return len;
+      }
+   }
+}
+
+/* shortest digits of positive finite val, which are read back to val: val = digits * 10^K. Grisu2 of F. Loitsch */
+static int32_t grisu2(double val, char* digits, int32_t* K)
+{
+   uint64_t bits = 0;
+   memcpy(&bits, &val, sizeof(bits));
+   uint64_t const hidden = 1ull << 52;
+   int32_t const biasedExp = (int32_t)(bits >> 52) & 0x7FF;
+   DiyFp v = {bits & (hidden - 1), -1074};
+   if (biasedExp)
+   {
+      v.f |= hidden;
+      v.e = biasedExp - 1075;
+   }
+   // boundaries of rounding interval with the same exponent
+   DiyFp plus = {(v.f << 1) + 1, v.e - 1};
+   uint32_t shift = CLZ64(plus.f);
+   plus.f <<= shift;
+   plus.e -= shift;
+   DiyFp minus = {(v.f << 1) - 1, v.e - 1};
+   if (v.f == hidden && biasedExp > 1) // lower neighbour is closer
+   {
+      minus.f = (v.f << 2) - 1;
+      minus.e = v.e - 2;
+   }
+   minus.f <<= minus.e - plus.e;
+   minus.e = plus.e;
+   shift = CLZ64(v.f);
+   v.f <<= shift;
+   v.e -= shift;
+   // 10^-K brings binary exponent of products into [-60, -32]
+   double const dk = (-61 - plus.e) * 0.30102999566398114 + 347;
+   int32_t k = (int32_t)dk;
+   if (dk - k > 0.0)
+   {
+      ++k;
+   }
+   uint32_t const idx = (uint32_t)((k >> 3) + 1);
+   *K = 348 - (int32_t)(idx << 3);
+   DiyFp const c = cached_pow10[idx];
+   DiyFp const w = diyfp_mul(v, c);
+   DiyFp wp = diyfp_mul(plus, c);
+   DiyFp wm = diyfp_mul(minus, c);
+   ++wm.f;
+   --wp.f;
+   return grisu_digits(w, wp, wp.f - wm.f, digits, K);
+}
+
+/* write shortest representation of val in plain notation, FIX doesn't allow exponent */
+static int32_t dtoa_shortest(double val, char* buff)
+{
+   uint64_t bits = 0;
+   memcpy(&bits, &val, sizeof(bits));
+   if (((bits >> 52) & 0x7FF) == 0x7FF) // inf or nan
+   {
+      return 0;
+   }
+   if (!(bits << 1)) // +0 and -0
+   {
+      buff[0] = '0';
+      return 1;
+   }
+   int32_t i = 0;
+   if (val < 0)
+   {
+      buff[i++] = '-';
+      val = -val;
+   }
+   char digits[UINT64_MAX_DIGITS];
+   int32_t K = 0;
+   int32_t const len = grisu2(val, digits, &K);
+   int32_t const pt = len + K; // val = 0.digits * 10^pt
+   if (K >= 0)
+   {
+      memcpy(buff + i, digits, len);
+      memset(buff + i + len, '0', K);
+      return i + len + K;
+   }
+   if (pt > 0)
+   {
+      memcpy(buff + i, digits, pt);
+      buff[i + pt] = '.';
+      memcpy(buff + i + pt + 1, digits + pt, len - pt);
+      return i + len + 1;
+   }
+   buff[i++] = '0';
+   buff[i++] = '.';
+   memset(buff + i, '0', -pt);
+   memcpy(buff + i - pt, digits, len);
+   return i - pt + len;
+}
+
+/* write val with exactly precision decimals. Shortest digits of val are rounded half away from zero */
+static int32_t dtoa_fixed(double val, uint32_t precision, char* buff)
+{
+   uint64_t bits = 0;
+   memcpy(&bits, &val, sizeof(bits));
+   if (((bits >> 52) & 0x7FF) == 0x7FF) // inf or nan
+   {
+      return 0;
+   }
+   char storage[UINT64_MAX_DIGITS + 1];
+   char* digits = storage + 1; // room for carry
+   int32_t len = 0;
+   int32_t pt = 0;
+   if (bits << 1)
+   {
+      int32_t K = 0;
+      len = grisu2(val < 0 ? -val : val, digits, &K);
+      pt = len + K;
+   }
+   int32_t const keep = pt + (int32_t)precision;
+   if (keep < 0)
+   {
+      len = 0;
+   }
+   else if (keep < len)
+   {
+      int32_t const up = digits[keep] >= '5';
+      len = keep;
+      int32_t j = keep - 1;
+      while(up && j >= 0 && digits[j] == '9')
+      {
+         digits[j--] = '0';
+      }
+      if (up && j >= 0)
+      {
+         ++digits[j];
+      }
+      else if (up)
+      {
+         *--digits = '1';
+         ++len;
+         ++pt;
+      }
+   }
+   int32_t i = 0;
+   if (val < 0 && len > 0)
+   {
+      buff[i++] = '-';
+   }
+   if (pt <= 0)
+   {
+      buff[i++] = '0';
+   }
+   for(int32_t j = 0; j < pt; ++j)
+   {
+      buff[i++] = j < len ? digits[j] : '0';
+   }
+   if (precision)
+   {
+      buff[i++] = '.';
+      for(int32_t j = pt; j < pt + (int32_t)precision; ++j) // pt is moved by carry
+      {
+         buff[i++] = (j >= 0 && j < len) ? digits[j] : '0';
+      }
+   }
+   return i;
+}
+
+/* write mantissa * 10^exponent in plain notation. Decimals are written as is, so scale of value is kept */
+static int32_t dectoa(int64_t mantissa, int32_t exponent, char* buff)
+{
+   int32_t i = 0;
+   uint64_t mag = (uint64_t)mantissa;
+   if (mantissa < 0)
+   {
+      buff[i++] = '-';
+      mag = 0 - mag;
+   }
+   if (exponent >= 0)
+   {
+      uint32_t const nd = fix_utils_udigits(mag);
+      utoa_backward(mag, buff + i + nd);
+      i += nd;
+      if (mag)
+      {
+         memset(buff + i, '0', exponent);
+         i += exponent;
+      }
+      return i;
+   }
+   uint32_t const scale = -exponent;
+   uint64_t const intPart = mag / upow10[scale];
+   uint32_t const nd = fix_utils_udigits(intPart);
+   utoa_backward(intPart, buff + i + nd);
+   i += nd;
+   buff[i++] = '.';
+   memset(buff + i, '0', scale);
+   utoa_backward(mag % upow10[scale], buff + i + scale);
+   return i + scale;
+}
+
+static checksum_func checksum_impl = &checksum_resolve;
+static int32_t simd_level = -1;
 
 /*-----------------------------------------------------------------------------------------------------------------------*/
 uint32_t fix_utils_hash_string(char const* s, uint32_t len)
@@ -36,14 +412,7 @@ uint32_t fix_utils_hash_string(char const* s, uint32_t len)
 /*-----------------------------------------------------------------------------------------------------------------------*/
 int32_t fix_utils_numdigits(int64_t val)
 {
-   int32_t cnt = 0;
-   do
-   {
-      ++cnt;
-      val /= 10;
-   }
-   while(val);
-   return cnt;
+   return fix_utils_udigits(val < 0 ? 0 - (uint64_t)val : (uint64_t)val);
 }
 
 /*-----------------------------------------------------------------------------------------------------------------------*/
@@ -78,73 +447,80 @@ int64_t fix_utils_lpow10(int32_t n)
 int32_t fix_utils_i64toa(int64_t val, char* buff, uint32_t buffLen, char padSym)
 {
    int32_t i = 0;
+   uint64_t uval = (uint64_t)val;
    if (val < 0)
    {
+      uval = 0 - uval;
+      if (!buffLen)
+      {
+         return 1 + fix_utils_udigits(uval);
+      }
       buff[i++] = '-';
-      val = -val;
       --buffLen;
    }
-   int32_t nd = fix_utils_numdigits(val);
-   for(uint32_t len = buffLen - nd; len > 0 && padSym; --len)
+   uint32_t const nd = fix_utils_udigits(uval);
+   if (padSym && nd < buffLen)
    {
-      buff[i++] = padSym;
+      memset(buff + i, padSym, buffLen - nd);
+      i += buffLen - nd;
+      buffLen = nd;
    }
-   for(; buffLen && nd; ++i, --nd, --buffLen)
+   if (LIKE(nd <= buffLen))
    {
-      int64_t pow = fix_utils_lpow10(nd - 1);
-      int64_t digit = val/pow;
-      buff[i] = digit + 48;
-      val -= (pow * digit);
+      utoa_backward(uval, buff + i + nd);
+      return i + nd;
    }
+   char tmp[UINT64_MAX_DIGITS];
+   utoa_backward(uval, tmp + nd);
+   memcpy(buff + i, tmp, buffLen); // leading digits, which fit
    return i + nd;
 }
 
 /*-----------------------------------------------------------------------------------------------------------------------*/
 int32_t fix_utils_dtoa(double val, char* buff, uint32_t buffLen)
 {
-   int32_t i = 0;
-   if (val < 0)
+   if (buffLen >= FIX_DTOA_BUFF_LEN)
    {
-      buff[i++] = '-';
-      val = -val;
-      --buffLen;
+      return dtoa_shortest(val, buff);
    }
-   int64_t m = (int64_t)val;
-   int32_t nd = fix_utils_numdigits(val);
-   int32_t j = nd;
-   for(; buffLen && j; ++i, --j, --buffLen)
+   char tmp[FIX_DTOA_BUFF_LEN];
+   int32_t const len = dtoa_shortest(val, tmp);
+   memcpy(buff, tmp, (uint32_t)len < buffLen ? (uint32_t)len : buffLen);
+   return len;
+}
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+int32_t fix_utils_dtoa_fixed(double val, uint32_t precision, char* buff, uint32_t buffLen)
+{
+   if (precision > FIX_DTOA_MAX_PRECISION)
    {
-      int64_t pow = fix_utils_lpow10(j - 1);
-      int32_t digit = (int32_t)m/pow;
-      buff[i] = digit + 48;
-      m -= (pow * digit);
+      precision = FIX_DTOA_MAX_PRECISION;
    }
-   i += j;
-   m = (int64_t)(val * fix_utils_lpow10(DOUBLE_MAX_DIGITS - nd)) - (int64_t)val * fix_utils_lpow10(DOUBLE_MAX_DIGITS - nd);
-   if (m)
+   if (buffLen >= FIX_DTOA_BUFF_LEN)
    {
-      if (buffLen)
-      {
-         buff[i] = '.';
-		 --buffLen;
-      }
-      ++i;
+      return dtoa_fixed(val, precision, buff);
    }
-   j = DOUBLE_MAX_DIGITS - nd;
-   for(; buffLen && m && j; ++i, --j, --buffLen)
+   char tmp[FIX_DTOA_BUFF_LEN];
+   int32_t const len = dtoa_fixed(val, precision, tmp);
+   memcpy(buff, tmp, (uint32_t)len < buffLen ? (uint32_t)len : buffLen);
+   return len;
+}
+
+/*-----------------------------------------------------------------------------------------------------------------------*/
+int32_t fix_utils_dectoa(int64_t mantissa, int32_t exponent, char* buff, uint32_t buffLen)
+{
+   if (exponent < -FIX_DEC_MAX_EXPONENT || exponent > FIX_DEC_MAX_EXPONENT)
    {
-      int64_t pow = fix_utils_lpow10(j - 1);
-      int64_t digit = m/pow;
-      buff[i] = digit + 48;
-      m -= (pow * digit);
+      return 0;
    }
-   for(; m && j; ++i, --j)
+   if (buffLen >= FIX_DECTOA_BUFF_LEN)
    {
-      int64_t pow = fix_utils_lpow10(j - 1);
-      int64_t digit = m/pow;
-      m -= (pow * digit);
+      return dectoa(mantissa, exponent, buff);
    }
-   return i;
+   char tmp[FIX_DECTOA_BUFF_LEN];
+   int32_t const len = dectoa(mantissa, exponent, tmp);
+   memcpy(buff, tmp, (uint32_t)len < buffLen ? (uint32_t)len : buffLen);
+   return len;
 }
 
 /*-----------------------------------------------------------------------------------------------------------------------*/
@@ -274,7 +650,10 @@ FIXErrCode fix_utils_atod(char const* buff, uint32_t buffLen, char stopChar, dou
       {
          return FIX_FAILED;
       }
-      exp += (double)(buff[*cnt] - 48) / fix_utils_lpow10(j);
+      if (j < 19) /* further digits are below double precision and past the fix_utils_lpow10 table */
+      {
+         exp += (double)(buff[*cnt] - 48) / fix_utils_lpow10(j);
+      }
    }
    if (stopChar && *cnt == buffLen)
    {
@@ -286,6 +665,93 @@ FIXErrCode fix_utils_atod(char const* buff, uint32_t buffLen, char stopChar, dou
    return FIX_SUCCESS;
 }
 
+/*------------------------------------------------------------------------------------------------------------------------*/
+FIXErrCode fix_utils_atodec(char const* buff, uint32_t buffLen, char stopChar, int64_t* mantissa, int32_t* exponent,
+      int32_t* cnt)
+{
+   if (stopChar && !buffLen)
+   {
+      return FIX_ERROR_NO_MORE_DATA;
+   }
+   else if (!buff || !buffLen || !mantissa || !exponent)
+   {
+      return FIX_ERROR_INVALID_ARGUMENT;
+   }
+   *mantissa = 0;
+   *exponent = 0;
+   *cnt = 0;
+   int32_t negative = 0;
+   if (buff[*cnt] == '-')
+   {
+      negative = 1;
+      ++(*cnt);
+   }
+   uint64_t const limit = negative ? (uint64_t)INT64_MAX + 1 : (uint64_t)INT64_MAX;
+   uint64_t mag = 0;
+   uint32_t digits = 0;
+   uint32_t zeros = 0; // trailing zeros of decimals, which are not added to mag yet
+   int32_t point = 0;
+   int32_t scale = 0;
+   for(; *cnt < buffLen; ++(*cnt))
+   {
+      char const ch = buff[*cnt];
+      if (stopChar && stopChar == ch)
+      {
+         break;
+      }
+      if (ch == '.' && !point)
+      {
+         point = 1;
+         continue;
+      }
+      uint32_t const d = (uint32_t)(ch - '0');
+      if (d > 9)
+      {
+         return FIX_FAILED;
+      }
+      ++digits;
+      if (!point)
+      {
+         if (mag > (limit - d) / 10)
+         {
+            return FIX_FAILED;
+         }
+         mag = mag * 10 + d;
+      }
+      else if (!d)
+      {
+         ++zeros;
+      }
+      else
+      {
+         uint32_t const n = zeros + 1;
+         if (n >= UINT64_MAX_DIGITS || (mag && mag > (limit - d) / upow10[n]))
+         {
+            return FIX_FAILED;
+         }
+         mag = mag * upow10[n] + d;
+         scale += n;
+         zeros = 0;
+      }
+   }
+   if (stopChar && *cnt == buffLen)
+   {
+      return FIX_ERROR_NO_MORE_DATA;
+   }
+   if (!digits)
+   {
+      return FIX_FAILED;
+   }
+   for(; zeros && mag <= limit / 10; --zeros) // keep scale as written, while it fits
+   {
+      mag *= 10;
+      ++scale;
+   }
+   *mantissa = negative ? (int64_t)(0 - mag) : (int64_t)mag;
+   *exponent = -scale;
+   return FIX_SUCCESS;
+}
+
 /*------------------------------------------------------------------------------------------------------------------------*/
 FIXErrCode fix_utils_make_path(char const* protocolFile, char const* transpFile, char* path, uint32_t buffLen)
 {
@@ -311,3 +777,358 @@ FIXErrCode fix_utils_make_path(char const* protocolFile, char const* transpFile,
    free(protocolFileDup);
    return ret;
 }
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+void* fix_utils_alloc(FIXAllocator const* allocator, size_t size)
+{
+   if (!allocator || !allocator->alloc || !allocator->free)
+   {
+      return calloc(1, size);
+   }
+   void* ptr = allocator->alloc(allocator->ctx, size);
+   if (ptr)
+   {
+      memset(ptr, 0, size);
+   }
+   return ptr;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+void fix_utils_free(FIXAllocator const* allocator, void* ptr)
+{
+   if (!allocator || !allocator->alloc || !allocator->free)
+   {
+      free(ptr);
+   }
+   else if (ptr)
+   {
+      allocator->free(allocator->ctx, ptr);
+   }
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+char* fix_utils_strdup(FIXAllocator const* allocator, char const* str)
+{
+   size_t const len = strlen(str) + 1;
+   char* copy = (char*)fix_utils_alloc(allocator, len);
+   if (copy)
+   {
+      memcpy(copy, str, len);
+   }
+   return copy;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+void* fix_utils_slab_alloc(uint64_t* size, uint32_t flags, uint32_t numaNode)
+{
+   uint64_t const align = (flags & POOL_FLAG_HUGE_PAGES) ? HUGE_PAGE_SIZE : OS_PAGE_SIZE;
+   *size = (*size + align - 1) / align * align;
+   if ((flags & POOL_FLAG_NUMA) && numaNode > NUMA_MAX_NODE)
+   {
+      errno = EINVAL;
+      return NULL;
+   }
+#ifdef WIN32
+   char* slab = (flags & POOL_FLAG_NUMA) ?
+      (char*)VirtualAllocExNuma(GetCurrentProcess(), NULL, *size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE, numaNode) :
+      (char*)VirtualAlloc(NULL, *size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+   if (!slab)
+   {
+      return NULL;
+   }
+   if ((flags & POOL_FLAG_LOCK) && !VirtualLock(slab, *size))
+   {
+      VirtualFree(slab, 0, MEM_RELEASE);
+      return NULL;
+   }
+#else
+   char* slab = MAP_FAILED;
+#ifdef MAP_HUGETLB
+   if (flags & POOL_FLAG_HUGE_PAGES)
+   {
+      slab = (char*)mmap(NULL, *size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+   }
+#endif
+   if (slab == MAP_FAILED) // no reserved huge pages, fall back to regular (or transparent huge) pages
+   {
+      slab = (char*)mmap(NULL, *size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+      if (slab == MAP_FAILED)
+      {
+         return NULL;
+      }
+#ifdef MADV_HUGEPAGE
+      if (flags & POOL_FLAG_HUGE_PAGES)
+      {
+         madvise(slab, *size, MADV_HUGEPAGE);
+      }
+#endif
+   }
+   // policy must be set before the first touch, i.e. before mlock and prefault
+   if (flags & POOL_FLAG_NUMA)
+   {
+      unsigned long const nodeMask = 1ul << numaNode; // numaNode is checked against NUMA_MAX_NODE above
+      if (syscall(SYS_mbind, slab, *size, NUMA_MPOL_BIND, &nodeMask, sizeof(nodeMask) * 8 + 1, 0))
+      {
+         int const err = errno;
+         munmap(slab, *size);
+         errno = err;
+         return NULL;
+      }
+   }
+   if ((flags & POOL_FLAG_LOCK) && mlock(slab, *size))
+   {
+      int const err = errno;
+      munmap(slab, *size);
+      errno = err;
+      return NULL;
+   }
+#endif
+   if (flags & POOL_FLAG_PREFAULT)
+   {
+      for(uint64_t offset = 0; offset < *size; offset += OS_PAGE_SIZE)
+      {
+         ((char volatile*)slab)[offset] = 0;
+      }
+   }
+   return slab;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+void fix_utils_slab_free(void* slab, uint64_t size)
+{
+   if (!slab)
+   {
+      return;
+   }
+#ifdef WIN32
+   (void)size;
+   VirtualFree(slab, 0, MEM_RELEASE);
+#else
+   munmap(slab, size);
+#endif
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+static char const* find_char_plain(char const* buff, uint32_t buffLen, char ch)
+{
+   for(char const* end = buff + buffLen; buff != end; ++buff)
+   {
+      if (*buff == ch)
+      {
+         return buff;
+      }
+   }
+   return NULL;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+static uint32_t checksum_plain(char const* buff, uint32_t buffLen)
+{
+   uint32_t sum = 0;
+   for(char const* end = buff + buffLen; buff != end; ++buff)
+   {
+      sum += (unsigned char)*buff;
+   }
+   return sum;
+}
+
+#ifdef FIX_UTILS_X86
+/*------------------------------------------------------------------------------------------------------------------------*/
+/* SIMD scanners load whole aligned blocks, so they never cross a page boundary, but may touch bytes around the buffer.  */
+/* Matches outside of [buff, buff + buffLen) are discarded. Such reads are intended, so ASan is disabled for them.        */
+/*------------------------------------------------------------------------------------------------------------------------*/
+__attribute__((target("sse2"), no_sanitize_address))
+static char const* find_char_sse2(char const* buff, uint32_t buffLen, char ch)
+{
+   if (!buffLen)
+   {
+      return NULL;
+   }
+   char const* end = buff + buffLen;
+   __m128i const pattern = _mm_set1_epi8(ch);
+   uint32_t const misalign = (uintptr_t)buff & 15;
+   char const* block = buff - misalign;
+   uint32_t mask = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_load_si128((__m128i const*)block), pattern)) >> misalign;
+   if (mask)
+   {
+      char const* res = buff + __builtin_ctz(mask);
+      return res < end ? res : NULL;
+   }
+   for(block += 16; block < end; block += 16)
+   {
+      mask = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_load_si128((__m128i const*)block), pattern));
+      if (mask)
+      {
+         char const* res = block + __builtin_ctz(mask);
+         return res < end ? res : NULL;
+      }
+   }
+   return NULL;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+__attribute__((target("avx2"), no_sanitize_address))
+static char const* find_char_avx2(char const* buff, uint32_t buffLen, char ch)
+{
+   if (!buffLen)
+   {
+      return NULL;
+   }
+   char const* end = buff + buffLen;
+   __m256i const pattern = _mm256_set1_epi8(ch);
+   uint32_t const misalign = (uintptr_t)buff & 31;
+   char const* block = buff - misalign;
+   uint32_t mask = (uint32_t)_mm256_movemask_epi8(
+         _mm256_cmpeq_epi8(_mm256_load_si256((__m256i const*)block), pattern)) >> misalign;
+   if (mask)
+   {
+      char const* res = buff + __builtin_ctz(mask);
+      return res < end ? res : NULL;
+   }
+   for(block += 32; block < end; block += 32)
+   {
+      mask = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_load_si256((__m256i const*)block), pattern));
+      if (mask)
+      {
+         char const* res = block + __builtin_ctz(mask);
+         return res < end ? res : NULL;
+      }
+   }
+   return NULL;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+/* SIMD checksums sum bytes with psadbw against zero, so every 8 bytes collapse into one 64-bit lane.                    */
+/*------------------------------------------------------------------------------------------------------------------------*/
+__attribute__((target("sse2")))
+static uint32_t checksum_sse2(char const* buff, uint32_t buffLen)
+{
+   __m128i const zero = _mm_setzero_si128();
+   __m128i sum0 = zero;
+   __m128i sum1 = zero;
+   char const* end = buff + buffLen;
+   for(; end - buff >= 32; buff += 32)
+   {
+      sum0 = _mm_add_epi64(sum0, _mm_sad_epu8(_mm_loadu_si128((__m128i const*)buff), zero));
+      sum1 = _mm_add_epi64(sum1, _mm_sad_epu8(_mm_loadu_si128((__m128i const*)(buff + 16)), zero));
+   }
+   if (end - buff >= 16)
+   {
+      sum0 = _mm_add_epi64(sum0, _mm_sad_epu8(_mm_loadu_si128((__m128i const*)buff), zero));
+      buff += 16;
+   }
+   sum0 = _mm_add_epi64(sum0, sum1);
+   sum0 = _mm_add_epi64(sum0, _mm_unpackhi_epi64(sum0, sum0));
+   return (uint32_t)_mm_cvtsi128_si32(sum0) + checksum_plain(buff, end - buff);
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+__attribute__((target("avx2")))
+static uint32_t checksum_avx2(char const* buff, uint32_t buffLen)
+{
+   __m256i const zero = _mm256_setzero_si256();
+   __m256i sum0 = zero;
+   __m256i sum1 = zero;
+   char const* end = buff + buffLen;
+   for(; end - buff >= 64; buff += 64)
+   {
+      sum0 = _mm256_add_epi64(sum0, _mm256_sad_epu8(_mm256_loadu_si256((__m256i const*)buff), zero));
+      sum1 = _mm256_add_epi64(sum1, _mm256_sad_epu8(_mm256_loadu_si256((__m256i const*)(buff + 32)), zero));
+   }
+   if (end - buff >= 32)
+   {
+      sum0 = _mm256_add_epi64(sum0, _mm256_sad_epu8(_mm256_loadu_si256((__m256i const*)buff), zero));
+      buff += 32;
+   }
+   sum0 = _mm256_add_epi64(sum0, sum1);
+   __m128i sum = _mm_add_epi64(_mm256_castsi256_si128(sum0), _mm256_extracti128_si256(sum0, 1));
+   if (end - buff >= 16)
+   {
+      sum = _mm_add_epi64(sum, _mm_sad_epu8(_mm_loadu_si128((__m128i const*)buff), _mm_setzero_si128()));
+      buff += 16;
+   }
+   sum = _mm_add_epi64(sum, _mm_unpackhi_epi64(sum, sum));
+   return (uint32_t)_mm_cvtsi128_si32(sum) + checksum_plain(buff, end - buff);
+}
+#endif
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+static int32_t get_cpu_simd_level(void)
+{
+#ifdef FIX_UTILS_X86
+   __builtin_cpu_init();
+   if (__builtin_cpu_supports("avx2"))
+   {
+      return FIX_SIMD_AVX2;
+   }
+   if (__builtin_cpu_supports("sse2"))
+   {
+      return FIX_SIMD_SSE2;
+   }
+#endif
+   return FIX_SIMD_NONE;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+int32_t fix_utils_set_simd_level(int32_t level)
+{
+   int32_t const cpu_level = get_cpu_simd_level();
+   if (level > cpu_level)
+   {
+      level = cpu_level;
+   }
+   find_char_func impl = &find_char_plain;
+   checksum_func crc_impl = &checksum_plain;
+#ifdef FIX_UTILS_X86
+   if (level == FIX_SIMD_AVX2)
+   {
+      impl = &find_char_avx2;
+      crc_impl = &checksum_avx2;
+   }
+   else if (level == FIX_SIMD_SSE2)
+   {
+      impl = &find_char_sse2;
+      crc_impl = &checksum_sse2;
+   }
+#endif
+   simd_level = level < 0 ? FIX_SIMD_NONE : level;
+   find_char_impl = impl;
+   checksum_impl = crc_impl;
+   return simd_level;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+int32_t fix_utils_get_simd_level(void)
+{
+   if (simd_level < 0)
+   {
+      fix_utils_set_simd_level(FIX_SIMD_AVX2);
+   }
+   return simd_level;
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+static char const* find_char_resolve(char const* buff, uint32_t buffLen, char ch)
+{
+   fix_utils_set_simd_level(FIX_SIMD_AVX2);
+   return find_char_impl(buff, buffLen, ch);
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+char const* fix_utils_find_char(char const* buff, uint32_t buffLen, char ch)
+{
+   return find_char_impl(buff, buffLen, ch);
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+static uint32_t checksum_resolve(char const* buff, uint32_t buffLen)
+{
+   fix_utils_set_simd_level(FIX_SIMD_AVX2);
+   return checksum_impl(buff, buffLen);
+}
+
+/*------------------------------------------------------------------------------------------------------------------------*/
+uint32_t fix_utils_checksum(char const* buff, uint32_t buffLen)
+{
+   return checksum_impl(buff, buffLen) % 256;
+}
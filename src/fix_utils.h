@@ -12,11 +12,36 @@
 #ifndef WIN32
 #  define LIKE(x)    __builtin_expect(!!(x), 1)
 #  define UNLIKE(x)  __builtin_expect(!!(x), 0)
+#  define CTZ64(x)   __builtin_ctzll(x)
+#  define CLZ64(x)   __builtin_clzll(x)
+#  define LOG2_32(x) (31 - __builtin_clz(x))
 #  define _strdup strdup
 #else
+#  include <intrin.h>
 #  define LIKE(x) x
 #  define UNLIKE(x) x
+#  define CTZ64(x) fix_utils_ctz64(x)
+#  define CLZ64(x) fix_utils_clz64(x)
+#  define LOG2_32(x) fix_utils_log2_32(x)
 #  define PATH_MAX 4096
+static __inline uint32_t fix_utils_ctz64(uint64_t x)
+{
+   unsigned long idx = 0;
+   _BitScanForward64(&idx, x);
+   return idx;
+}
+static __inline uint32_t fix_utils_clz64(uint64_t x)
+{
+   unsigned long idx = 0;
+   _BitScanReverse64(&idx, x);
+   return 63 - idx;
+}
+static __inline uint32_t fix_utils_log2_32(uint32_t x)
+{
+   unsigned long idx = 0;
+   _BitScanReverse(&idx, x);
+   return idx;
+}
 #endif
 
 #ifdef __cplusplus
@@ -24,6 +49,15 @@ extern "C"
 {
 #endif
 
+#define FIX_DTOA_MAX_PRECISION 17 ///< maximum precision of fix_utils_dtoa_fixed
+#define FIX_DTOA_BUFF_LEN 352     ///< buffer length, which is enough for any double in plain notation
+#define FIX_DEC_MAX_EXPONENT 18   ///< maximum absolute exponent of fix_utils_dectoa
+#define FIX_DECTOA_BUFF_LEN 40    ///< buffer length, which is enough for any decimal of fix_utils_dectoa
+
+#define FIX_SIMD_NONE 0 ///< plain C implementation
+#define FIX_SIMD_SSE2 1 ///< SSE2 implementation
+#define FIX_SIMD_AVX2 2 ///< AVX2 implementation
+
 /**
  * calculate string hash value
  * @param[in] s - string for hash calculation
@@ -56,15 +90,39 @@ int64_t fix_utils_lpow10(int32_t n);
 int32_t fix_utils_i64toa(int64_t val, char* buff, uint32_t buffLen, char padSym);
 
 /**
- * convert double to string
+ * convert double to the shortest string, which is read back to the same value. Exponent is never used
  * @param[in] val - converted value
  * @param[out] buff - buffer with converted value
- * @param[in] buffLen - length of buffer
+ * @param[in] buffLen - length of buffer. FIX_DTOA_BUFF_LEN is enough for any value
  * @return how many characters written (can be written). If this value greater than buffLen, value converted
- * incompletely
+ * incompletely. 0 - value is infinite or NaN
  */
 int32_t fix_utils_dtoa(double val, char* buff, uint32_t buffLen);
 
+/**
+ * convert double to string with fixed count of decimals, e.g. tick size of price
+ * @param[in] val - converted value
+ * @param[in] precision - count of decimals, at most FIX_DTOA_MAX_PRECISION. Shortest representation of val is
+ * rounded half away from zero, so 1.005 with precision 2 is "1.01"
+ * @param[out] buff - buffer with converted value
+ * @param[in] buffLen - length of buffer. FIX_DTOA_BUFF_LEN is enough for any value
+ * @return how many characters written (can be written). If this value greater than buffLen, value converted
+ * incompletely. 0 - value is infinite or NaN
+ */
+int32_t fix_utils_dtoa_fixed(double val, uint32_t precision, char* buff, uint32_t buffLen);
+
+/**
+ * convert scaled decimal mantissa * 10^exponent to string without floating point, e.g. (13515, -2) -> "135.15".
+ * Decimals are written as is, so (13510, -2) is "135.10"
+ * @param[in] mantissa - decimal mantissa
+ * @param[in] exponent - decimal exponent, in range [-FIX_DEC_MAX_EXPONENT, FIX_DEC_MAX_EXPONENT]
+ * @param[out] buff - buffer with converted value
+ * @param[in] buffLen - length of buffer. FIX_DECTOA_BUFF_LEN is enough for any value
+ * @return how many characters written (can be written). If this value greater than buffLen, value converted
+ * incompletely. 0 - exponent is out of range
+ */
+int32_t fix_utils_dectoa(int64_t mantissa, int32_t exponent, char* buff, uint32_t buffLen);
+
 /**
  * convert string to 32-bit number
  * @param[in] buff - string value
@@ -98,6 +156,20 @@ FIXErrCode fix_utils_atoi64(char const* buff, uint32_t buffLen, char stopChar, i
  */
 FIXErrCode fix_utils_atod(char const* buff, uint32_t buffLen, char stopChar, double* val, int32_t* cnt);
 
+/**
+ * convert string to scaled decimal without floating point, e.g. "135.10" -> (13510, -2). All written decimals are kept,
+ * trailing zeros are dropped only if mantissa overflows without them
+ * @param[in] buff - string value
+ * @param[in] buffLen - length of buffer
+ * @param[in] stopChar - stop parsing on this char. If stopChar == 0, processed till buffer end
+ * @param[out] mantissa - decimal mantissa
+ * @param[out] exponent - decimal exponent, always <= 0
+ * @param[out] cnt - how many characters processed
+ * @return possible parsing error, FIX_SUCCESS - if no error. FIX_FAILED - wrong value or mantissa overflows int64
+ */
+FIXErrCode fix_utils_atodec(char const* buff, uint32_t buffLen, char stopChar, int64_t* mantissa, int32_t* exponent,
+      int32_t* cnt);
+
 /**
  * fix transpFile path according to protocolFile path
  * @param[in] protocolFile - path to protocol file
@@ -109,6 +181,77 @@ FIXErrCode fix_utils_atod(char const* buff, uint32_t buffLen, char stopChar, dou
  */
 FIXErrCode fix_utils_make_path(char const* protocolFile, char const* transpFile, char* path, uint32_t buffLen);
 
+/**
+ * allocate zeroed memory by user allocator
+ * @param[in] allocator - user allocator. If allocator is NULL or any of its functions is NULL, calloc is used
+ * @param[in] size - size of memory
+ * @return allocated memory, NULL - no memory
+ */
+void* fix_utils_alloc(FIXAllocator const* allocator, size_t size);
+
+/**
+ * free memory allocated by fix_utils_alloc
+ * @param[in] allocator - user allocator, the same as passed to fix_utils_alloc
+ * @param[in] ptr - memory to free. Can be NULL
+ */
+void fix_utils_free(FIXAllocator const* allocator, void* ptr);
+
+/**
+ * duplicate string by user allocator
+ * @param[in] allocator - user allocator, see fix_utils_alloc
+ * @param[in] str - string to duplicate
+ * @return string copy, NULL - no memory
+ */
+char* fix_utils_strdup(FIXAllocator const* allocator, char const* str);
+
+/**
+ * allocate zeroed memory region directly from OS
+ * @param[in,out] size - requested size of region, on return - real size, which must be passed to fix_utils_slab_free
+ * @param[in] flags - POOL_FLAG_HUGE_PAGES, POOL_FLAG_LOCK, POOL_FLAG_PREFAULT, POOL_FLAG_NUMA. Huge pages are used if
+ * possible, other flags must succeed
+ * @param[in] numaNode - NUMA node, region is bound to. Used only with POOL_FLAG_NUMA
+ * @return allocated region, NULL - error, see errno
+ */
+void* fix_utils_slab_alloc(uint64_t* size, uint32_t flags, uint32_t numaNode);
+
+/**
+ * free memory region allocated by fix_utils_slab_alloc
+ * @param[in] slab - memory region
+ * @param[in] size - size of region returned by fix_utils_slab_alloc
+ */
+void fix_utils_slab_free(void* slab, uint64_t size);
+
+/**
+ * find first occurrence of char in buffer. Best implementation (AVX2, SSE2 or plain C) is selected at first call
+ * @param[in] buff - buffer to search in
+ * @param[in] buffLen - length of buffer
+ * @param[in] ch - char to find
+ * @return pointer to found char, NULL - char not found
+ */
+char const* fix_utils_find_char(char const* buff, uint32_t buffLen, char ch);
+
+/**
+ * calculate FIX CheckSum, i.e. sum of all bytes modulo 256. Best implementation is selected at first call
+ * @param[in] buff - buffer with FIX data
+ * @param[in] buffLen - length of buffer
+ * @return CheckSum value in range [0, 255]
+ */
+uint32_t fix_utils_checksum(char const* buff, uint32_t buffLen);
+
+/**
+ * return SIMD level used by fix_utils_find_char and fix_utils_checksum
+ * @return FIX_SIMD_NONE, FIX_SIMD_SSE2 or FIX_SIMD_AVX2
+ */
+int32_t fix_utils_get_simd_level(void);
+
+/**
+ * force SIMD level used by fix_utils_find_char and fix_utils_checksum. Level is lowered to the best one supported by CPU
+ * @param[in] level - requested level, see FIX_SIMD_* values
+ * @return level actually set
+ * @note intended for tests and benchmarks
+ */
+int32_t fix_utils_set_simd_level(int32_t level);
+
 
 #ifdef __cplusplus
 }
@@ -14,28 +14,59 @@
 #include <gtest/gtest.h>
 #include <stdlib.h>
 
-FIXMsg* new_fake_message(FIXParser* parser)
-{
-   FIXError* error = NULL;
-   FIXMsg* msg = (FIXMsg*)calloc(1, sizeof(FIXMsg));
-   msg->fields = fix_parser_alloc_group(parser, &error);
-   msg->parser = parser;
-   msg->pages = msg->curr_page = fix_parser_alloc_page(parser, 0, &error);
-   return msg;
-}
-
-FIXFieldDescr* new_fdescr(int tag, FIXFieldCategoryEnum category, FIXFieldValueTypeEnum valueType)
+FIXFieldDescr new_fdescr(int tag, FIXFieldCategoryEnum category, FIXFieldValueTypeEnum valueType)
 {
    // it will be leaks, but who cares...
    FIXFieldType* type = (FIXFieldType*)calloc(sizeof(FIXFieldType), 1);
    type->tag = tag;
    type->valueType = valueType;
-   FIXFieldDescr* fdescr = (FIXFieldDescr*)calloc(sizeof(FIXFieldDescr), 1);
-   fdescr->type = type;
-   fdescr->category = category;
+   FIXFieldDescr fdescr;
+   memset(&fdescr, 0, sizeof(fdescr));
+   fdescr.type = type;
+   fdescr.category = category;
    return fdescr;
 }
 
+void index_fdescrs(FIXFieldDescr* fields, uint32_t count, FIXTagIndex* index)
+{
+   memset(index, 0, sizeof(FIXTagIndex));
+   index->dense_size = 256;
+   index->dense = (uint16_t*)calloc(index->dense_size, sizeof(uint16_t));
+   for(uint32_t i = 0; i < count; ++i)
+   {
+      index->dense[fields[i].type->tag] = i + 1;
+      fields[i].ordinal = i;
+   }
+}
+
+void set_group_fdescrs(FIXFieldDescr* fdescr, FIXFieldDescr* group, uint32_t count)
+{
+   fdescr->group = group;
+   fdescr->group_count = count;
+   index_fdescrs(group, count, &fdescr->group_index);
+}
+
+// page offset after block of size is allocated at offset. Block is 8-byte aligned and preceded by 4-byte size
+uint32_t block_end(uint32_t offset, uint32_t size)
+{
+   return ((offset + 4 + 7) & ~7u) + size;
+}
+
+FIXMsg* new_fake_message(FIXParser* parser, FIXFieldDescr* fields, uint32_t count)
+{
+   FIXError* error = NULL;
+   FIXMsgDescr* descr = (FIXMsgDescr*)calloc(1, sizeof(FIXMsgDescr));
+   descr->field_count = count;
+   descr->fields = fields;
+   index_fdescrs(fields, count, &descr->field_index);
+   FIXMsg* msg = (FIXMsg*)calloc(1, sizeof(FIXMsg));
+   msg->parser = parser;
+   msg->descr = descr;
+   msg->pages = msg->curr_page = fix_parser_alloc_page(parser, 0, &error);
+   msg->fields = fix_msg_alloc_group(msg, NULL, &error);
+   return msg;
+}
+
 TEST(FixFieldTests, SetTagTest)
 {
    FIXError* error = NULL;
@@ -43,81 +74,83 @@ TEST(FixFieldTests, SetTagTest)
    FIXParser* parser = fix_parser_create("fix_descr/fix.4.4.xml", &attrs, PARSER_FLAG_CHECK_ALL, &error);
    ASSERT_TRUE(parser != NULL);
 
-   FIXMsg* msg = new_fake_message(parser);
+   FIXFieldDescr fields[] =
+   {
+      new_fdescr(1, FIXFieldCategory_Value, FIXFieldValueType_String),
+      new_fdescr(2, FIXFieldCategory_Value, FIXFieldValueType_String),
+      new_fdescr(30, FIXFieldCategory_Value, FIXFieldValueType_String)
+   };
+   FIXMsg* msg = new_fake_message(parser, fields, 3);
+   ASSERT_EQ(msg->fields->field_count, 3U);
+   uint32_t const slots = block_end(0, 3 * sizeof(FIXField*) + sizeof(uint64_t)); // slots and occupancy bitmap
+   ASSERT_EQ(msg->curr_page->offset, slots);
 
    char const val[] = {"1000"};
-   FIXField* field = fix_field_set(msg, NULL, new_fdescr(1, FIXFieldCategory_Value, FIXFieldValueType_String),
-         (unsigned char const*)val, strlen(val), &error);
-   ASSERT_EQ(msg->fields->fields[1], field);
+   FIXField* field = fix_field_set(msg, NULL, &fields[0], (unsigned char const*)val, strlen(val), &error);
+   ASSERT_EQ(msg->fields->fields[0], field);
    ASSERT_TRUE(field->descr != NULL);
    ASSERT_EQ(field->descr->type->tag, 1);
    ASSERT_EQ(field->descr->category, FIXFieldCategory_Value);
-   ASSERT_TRUE(field->next == NULL);
    ASSERT_TRUE(!strncmp((char const*)field->data, val, strlen(val)));
    ASSERT_EQ(field->size, strlen(val));
 
    ASSERT_EQ(msg->curr_page->size, 512U);
-   ASSERT_EQ(msg->curr_page->offset, 4 + sizeof(FIXField) + 4 + strlen(val));
+   ASSERT_EQ(msg->curr_page->offset, block_end(block_end(slots, sizeof(FIXField)), strlen(val)));
    ASSERT_TRUE(msg->curr_page->next == NULL);
 
-   FIXField* field11 = fix_field_set(msg, NULL, new_fdescr(2, FIXFieldCategory_Value, FIXFieldValueType_String),
-         (unsigned char const*)val, strlen(val), &error);
-   ASSERT_EQ(msg->fields->fields[2], field11);
+   FIXField* field11 = fix_field_set(msg, NULL, &fields[1], (unsigned char const*)val, strlen(val), &error);
+   ASSERT_EQ(msg->fields->fields[1], field11);
    ASSERT_EQ(field11->descr->type->tag, 2);
    ASSERT_EQ(field11->descr->category, FIXFieldCategory_Value);
-   ASSERT_TRUE(field11->next == NULL);
    ASSERT_TRUE(!strncmp((char const*)field11->data, val, strlen(val)));
    ASSERT_EQ(field11->size, strlen(val));
 
-   FIXField* field12 = fix_field_set(msg, NULL, new_fdescr(30, FIXFieldCategory_Value, FIXFieldValueType_String),
-         (unsigned char const*)val, strlen(val), &error);
-   ASSERT_EQ(msg->fields->fields[30], field12);
+   FIXField* field12 = fix_field_set(msg, NULL, &fields[2], (unsigned char const*)val, strlen(val), &error);
+   ASSERT_EQ(msg->fields->fields[2], field12);
    ASSERT_EQ(field12->descr->type->tag, 30);
    ASSERT_EQ(field12->descr->category, FIXFieldCategory_Value);
-   ASSERT_TRUE(field12->next == NULL);
    ASSERT_TRUE(!strncmp((char const*)field12->data, val, strlen(val)));
    ASSERT_EQ(field12->size, strlen(val));
 
    char const val1[] = {"2000"};
-   FIXField* field1 = fix_field_set(msg, NULL, new_fdescr(1, FIXFieldCategory_Value, FIXFieldValueType_String),
-         (unsigned char const*)val1, strlen(val1), &error);
+   FIXField* field1 = fix_field_set(msg, NULL, &fields[0], (unsigned char const*)val1, strlen(val1), &error);
    ASSERT_EQ(field, field1);
    ASSERT_EQ(field1->descr->type->tag, 1);
    ASSERT_EQ(field1->descr->category, FIXFieldCategory_Value);
-   ASSERT_TRUE(field1->next == NULL);
    ASSERT_TRUE(!strncmp((char const*)field1->data, val1, strlen(val1)));
    ASSERT_EQ(field1->size, strlen(val1));
 
+   uint32_t used = slots;
+   for(int i = 0; i < 3; ++i) // value of the same size is overwritten in place
+   {
+      used = block_end(block_end(used, sizeof(FIXField)), strlen(val));
+   }
    ASSERT_EQ(msg->curr_page->size, 512U);
-   ASSERT_EQ(msg->curr_page->offset, 3 * (4 + sizeof(FIXField)) + 4 + strlen(val1) + 4 + strlen(val) + 4 + strlen(val));
+   ASSERT_EQ(msg->curr_page->offset, used);
    ASSERT_TRUE(msg->curr_page->next == NULL);
 
    char const val2[] = {"64"};
-   FIXField* field2 = fix_field_set(msg, NULL, new_fdescr(1, FIXFieldCategory_Value, FIXFieldValueType_String),
-         (unsigned char const*)val2, strlen(val2), &error);
+   FIXField* field2 = fix_field_set(msg, NULL, &fields[0], (unsigned char const*)val2, strlen(val2), &error);
    ASSERT_EQ(field2, field);
    ASSERT_EQ(field2->descr->type->tag, 1);
    ASSERT_EQ(field2->descr->category, FIXFieldCategory_Value);
-   ASSERT_TRUE(field2->next == NULL);
    ASSERT_TRUE(!strncmp((char const*)field2->data, val2, strlen(val2)));
    ASSERT_EQ(field1->size, strlen(val2));
 
    ASSERT_EQ(msg->curr_page->size, 512U);
-   ASSERT_EQ(msg->curr_page->offset, 3 * (4 + sizeof(FIXField)) + 4 + strlen(val1) + 4 + strlen(val) + 4 + strlen(val));
+   ASSERT_EQ(msg->curr_page->offset, used);
    ASSERT_TRUE(msg->curr_page->next == NULL);
 
    char const txt[] = "Hello world!";
-   FIXField* field3 = fix_field_set(msg, NULL, new_fdescr(1, FIXFieldCategory_Value, FIXFieldValueType_String),
-         (unsigned char const*)txt, strlen(txt), &error);
+   FIXField* field3 = fix_field_set(msg, NULL, &fields[0], (unsigned char const*)txt, strlen(txt), &error);
    ASSERT_EQ(field3, field);
    ASSERT_EQ(field3->descr->type->tag, 1);
    ASSERT_EQ(field3->descr->category, FIXFieldCategory_Value);
-   ASSERT_TRUE(field3->next == NULL);
    ASSERT_TRUE(!strncmp((char const*)field3->data, txt, strlen(txt)));
    ASSERT_EQ(field3->size, strlen(txt));
 
    ASSERT_EQ(msg->curr_page->size, 512U);
-   ASSERT_EQ(msg->curr_page->offset, 3 * (4 + sizeof(FIXField)) + 4 + strlen(val1) + 4 + strlen(val) + 4 + strlen(val) + 4 + strlen(txt));
+   ASSERT_EQ(msg->curr_page->offset, block_end(used, strlen(txt)));
    ASSERT_TRUE(msg->curr_page->next == NULL);
 
    fix_parser_free(parser);
@@ -131,86 +164,86 @@ TEST(FixFieldTests, DelTagTest)
    FIXParser* parser = fix_parser_create("fix_descr/fix.4.4.xml", &attrs, PARSER_FLAG_CHECK_ALL, &error);
    ASSERT_TRUE(parser != NULL);
 
-   FIXMsg* msg = new_fake_message(parser);
+   // all tags had the same key in old 64-bucket hash table
+   FIXFieldDescr fields[] =
+   {
+      new_fdescr(1, FIXFieldCategory_Value, FIXFieldValueType_Int),
+      new_fdescr(65, FIXFieldCategory_Value, FIXFieldValueType_Int),
+      new_fdescr(129, FIXFieldCategory_Value, FIXFieldValueType_Int),
+      new_fdescr(193, FIXFieldCategory_Value, FIXFieldValueType_Int)
+   };
+   FIXMsg* msg = new_fake_message(parser, fields, 4);
+   uint32_t const slots = block_end(0, 4 * sizeof(FIXField*) + sizeof(uint64_t));
 
    int val = 1000;
-   FIXField* field = fix_field_set(msg, NULL, new_fdescr(1, FIXFieldCategory_Value, FIXFieldValueType_Int),
-         (unsigned char const*)&val, sizeof(val), &error);
-   ASSERT_EQ(msg->fields->fields[1], field);
+   FIXField* field = fix_field_set(msg, NULL, &fields[0], (unsigned char const*)&val, sizeof(val), &error);
+   ASSERT_EQ(msg->fields->fields[0], field);
    ASSERT_EQ(field->descr->type->tag, 1);
    ASSERT_EQ(field->descr->category, FIXFieldCategory_Value);
-   ASSERT_TRUE(field->next == NULL);
-   ASSERT_EQ(*(long*)field->data, val);
+   ASSERT_EQ(*(int*)field->data, val);
 
    ASSERT_EQ(msg->curr_page->size, 512U);
-   ASSERT_EQ(msg->curr_page->offset, 4 + sizeof(FIXField) + 4 + sizeof(val));
+   ASSERT_EQ(msg->curr_page->offset, block_end(block_end(slots, sizeof(FIXField)), sizeof(val)));
    ASSERT_TRUE(msg->curr_page->next == NULL);
 
    uint32_t val1 = 2000;
-   FIXField* field1 = fix_field_set(msg, NULL, new_fdescr(65, FIXFieldCategory_Value, FIXFieldValueType_Int),
-         (unsigned char const*)&val1, sizeof(val1), &error);
+   FIXField* field1 = fix_field_set(msg, NULL, &fields[1], (unsigned char const*)&val1, sizeof(val1), &error);
    ASSERT_EQ(msg->fields->fields[1], field1);
    ASSERT_EQ(field1->descr->type->tag, 65);
-   ASSERT_EQ(field1->descr->category, FIXFieldCategory_Value);
-   ASSERT_EQ(field1->next, field);
-   ASSERT_EQ(*(uint64_t*)field1->data, val1);
-
-   ASSERT_EQ(msg->curr_page->size, 512U);
-   ASSERT_EQ(msg->curr_page->offset, 2 * (4 + sizeof(FIXField)) + 4 + sizeof(val) + 4 + sizeof(val1));
-   ASSERT_TRUE(msg->curr_page->next == NULL);
+   ASSERT_EQ(*(uint32_t*)field1->data, val1);
 
    uint32_t val2 = 3000;
-   FIXField* field2 = fix_field_set(msg, NULL, new_fdescr(129, FIXFieldCategory_Value, FIXFieldValueType_Int),
-         (unsigned char const*)&val2, sizeof(val2), &error);
-   ASSERT_EQ(msg->fields->fields[1], field2);
+   FIXField* field2 = fix_field_set(msg, NULL, &fields[2], (unsigned char const*)&val2, sizeof(val2), &error);
+   ASSERT_EQ(msg->fields->fields[2], field2);
    ASSERT_EQ(field2->descr->type->tag, 129);
-   ASSERT_EQ(field2->descr->category, FIXFieldCategory_Value);
-   ASSERT_EQ(field2->next, field1);
-   ASSERT_EQ(*(uint64_t*)field2->data, val2);
-
-   ASSERT_EQ(msg->curr_page->size, 512U);
-   ASSERT_EQ(msg->curr_page->offset, 3 * (4 + sizeof(FIXField)) + 4 + sizeof(val) + 4 + sizeof(val1) + 4 + sizeof(val));
-   ASSERT_TRUE(msg->curr_page->next == NULL);
+   ASSERT_EQ(*(uint32_t*)field2->data, val2);
 
    int val3 = 4000;
-   FIXField* field3 = fix_field_set(msg, NULL, new_fdescr(193, FIXFieldCategory_Value, FIXFieldValueType_Int),
-         (unsigned char const*)&val3, sizeof(val3), &error);
-
-   ASSERT_EQ(msg->fields->fields[1], field3);
+   FIXField* field3 = fix_field_set(msg, NULL, &fields[3], (unsigned char const*)&val3, sizeof(val3), &error);
+   ASSERT_EQ(msg->fields->fields[3], field3);
    ASSERT_EQ(field3->descr->type->tag, 193);
-   ASSERT_EQ(field3->descr->category, FIXFieldCategory_Value);
-   ASSERT_EQ(field3->next, field2);
-   ASSERT_EQ(*(long*)field3->data, val3);
+   ASSERT_EQ(*(int*)field3->data, val3);
 
+   uint32_t used = slots;
+   for(int i = 0; i < 4; ++i)
+   {
+      used = block_end(block_end(used, sizeof(FIXField)), sizeof(val));
+   }
    ASSERT_EQ(msg->curr_page->size, 512U);
-   ASSERT_EQ(msg->curr_page->offset, 4 * (4 + sizeof(FIXField)) + 4 + sizeof(val) + 4 + sizeof(val) + 4 + sizeof(val1) + 4 + sizeof(val3));
+   ASSERT_EQ(msg->curr_page->offset, used);
    ASSERT_TRUE(msg->curr_page->next == NULL);
 
    int res = fix_field_del(msg, NULL, 1, &error);
    ASSERT_EQ(res, FIX_SUCCESS);
-   ASSERT_EQ(msg->fields->fields[1], field3);
-   ASSERT_EQ(msg->fields->fields[1]->next, field2);
-   ASSERT_EQ(msg->fields->fields[1]->next->next, field1);
-   ASSERT_TRUE(msg->fields->fields[1]->next->next->next == NULL);
+   ASSERT_TRUE(msg->fields->fields[0] == NULL);
+   ASSERT_EQ(msg->fields->fields[1], field1);
+   ASSERT_EQ(msg->fields->fields[2], field2);
+   ASSERT_EQ(msg->fields->fields[3], field3);
 
-   ASSERT_EQ(msg->curr_page->size, 512U);
-   ASSERT_EQ(msg->curr_page->offset, 4 * (4 + sizeof(FIXField)) + 4 + sizeof(val) + 4 + sizeof(val) + 4 + sizeof(val1) + 4 + sizeof(val3));
-   ASSERT_TRUE(msg->curr_page->next == NULL);
+   ASSERT_EQ(msg->curr_page->offset, used);
 
    res = fix_field_del(msg, msg->fields, 129, &error);
    ASSERT_EQ(res, FIX_SUCCESS);
-   ASSERT_EQ(msg->fields->fields[1], field3);
-   ASSERT_EQ(msg->fields->fields[1]->next, field1);
-   ASSERT_TRUE(msg->fields->fields[1]->next->next == NULL);
+   ASSERT_TRUE(msg->fields->fields[2] == NULL);
+   ASSERT_EQ(msg->fields->fields[1], field1);
+   ASSERT_EQ(msg->fields->fields[3], field3);
+
+   res = fix_field_del(msg, msg->fields, 129, &error);
+   ASSERT_EQ(res, FIX_FAILED);
+   ASSERT_EQ(error->code, FIX_ERROR_FIELD_NOT_FOUND);
+   fix_error_free(error);
+   error = NULL;
 
    res = fix_field_del(msg, msg->fields, 193, &error);
    ASSERT_EQ(res, FIX_SUCCESS);
-   ASSERT_EQ(msg->fields->fields[1], field1);
-   ASSERT_TRUE(msg->fields->fields[1]->next == NULL);
+   ASSERT_TRUE(msg->fields->fields[3] == NULL);
 
    res = fix_field_del(msg, msg->fields, 65, &error);
    ASSERT_EQ(res, FIX_SUCCESS);
-   ASSERT_TRUE(msg->fields->fields[1] == NULL);
+   for(uint32_t i = 0; i < msg->fields->field_count; ++i)
+   {
+      ASSERT_TRUE(msg->fields->fields[i] == NULL);
+   }
 
    fix_parser_free(parser);
    free(msg);
@@ -223,69 +256,51 @@ TEST(FixFieldTests, GetTagTest)
    FIXParser* parser = fix_parser_create("fix_descr/fix.4.4.xml", &attrs, PARSER_FLAG_CHECK_ALL, &error);
    ASSERT_TRUE(parser != NULL);
 
-   FIXMsg* msg = new_fake_message(parser);
+   FIXFieldDescr fields[] =
+   {
+      new_fdescr(1, FIXFieldCategory_Value, FIXFieldValueType_String),
+      new_fdescr(65, FIXFieldCategory_Value, FIXFieldValueType_String),
+      new_fdescr(129, FIXFieldCategory_Value, FIXFieldValueType_String),
+      new_fdescr(193, FIXFieldCategory_Value, FIXFieldValueType_String),
+      new_fdescr(2, FIXFieldCategory_Value, FIXFieldValueType_String),
+      new_fdescr(3, FIXFieldCategory_Value, FIXFieldValueType_String)
+   };
+   FIXMsg* msg = new_fake_message(parser, fields, 6);
 
    long val = 1000;
-   FIXField* field = fix_field_set(msg, NULL, new_fdescr(1, FIXFieldCategory_Value, FIXFieldValueType_String),
-         (unsigned char const*)&val, sizeof(val), &error);
-   ASSERT_EQ(msg->fields->fields[1], field);
-   ASSERT_EQ(field->descr->type->tag, 1);
-   ASSERT_EQ(field->descr->category, FIXFieldCategory_Value);
-   ASSERT_TRUE(field->next == NULL);
+   FIXField* field = fix_field_set(msg, NULL, &fields[0], (unsigned char const*)&val, sizeof(val), &error);
+   ASSERT_EQ(msg->fields->fields[0], field);
    ASSERT_EQ(*(long*)field->data, val);
 
    long val1 = 2000;
-   FIXField* field1 = fix_field_set(msg, NULL, new_fdescr(65, FIXFieldCategory_Value, FIXFieldValueType_String),
-         (unsigned char const*)&val1, sizeof(val1), &error);
+   FIXField* field1 = fix_field_set(msg, NULL, &fields[1], (unsigned char const*)&val1, sizeof(val1), &error);
    ASSERT_EQ(msg->fields->fields[1], field1);
-   ASSERT_EQ(msg->fields->fields[1]->next, field);
-   ASSERT_EQ(field1->descr->type->tag, 65);
-   ASSERT_EQ(field1->descr->category, FIXFieldCategory_Value);
-   ASSERT_EQ(field1->next, field);
    ASSERT_EQ(*(long*)field1->data, val1);
 
    long val2 = 3000;
-   FIXField* field2 = fix_field_set(msg, NULL, new_fdescr(129, FIXFieldCategory_Value, FIXFieldValueType_String),
-         (unsigned char const*)&val2, sizeof(val2), &error);
-   ASSERT_EQ(msg->fields->fields[1], field2);
-   ASSERT_EQ(msg->fields->fields[1]->next, field1);
-   ASSERT_EQ(msg->fields->fields[1]->next->next, field);
-   ASSERT_EQ(field2->descr->type->tag, 129);
-   ASSERT_EQ(field2->descr->category, FIXFieldCategory_Value);
-   ASSERT_EQ(field2->next, field1);
+   FIXField* field2 = fix_field_set(msg, NULL, &fields[2], (unsigned char const*)&val2, sizeof(val2), &error);
+   ASSERT_EQ(msg->fields->fields[2], field2);
    ASSERT_EQ(*(long*)field2->data, val2);
 
    uint64_t val3 = 4000;
-   FIXField* field3 = fix_field_set(msg, NULL, new_fdescr(193, FIXFieldCategory_Value, FIXFieldValueType_String),
-         (unsigned char const*)&val3, sizeof(val3), &error);
-   ASSERT_EQ(msg->fields->fields[1], field3);
-   ASSERT_EQ(msg->fields->fields[1]->next, field2);
-   ASSERT_EQ(msg->fields->fields[1]->next->next, field1);
-   ASSERT_EQ(msg->fields->fields[1]->next->next->next, field);
-   ASSERT_EQ(field3->descr->type->tag, 193);
-   ASSERT_EQ(field3->descr->category, FIXFieldCategory_Value);
-   ASSERT_EQ(field3->next, field2);
+   FIXField* field3 = fix_field_set(msg, NULL, &fields[3], (unsigned char const*)&val3, sizeof(val3), &error);
+   ASSERT_EQ(msg->fields->fields[3], field3);
    ASSERT_EQ(*(uint64_t*)field3->data, val3);
 
    long val4 = 4000;
-   FIXField* field4 = fix_field_set(msg, NULL, new_fdescr(2, FIXFieldCategory_Value, FIXFieldValueType_String),
-         (unsigned char const*)&val4, sizeof(val4), &error);
-   ASSERT_EQ(msg->fields->fields[1], field3);
-   ASSERT_EQ(msg->fields->fields[1]->next, field2);
-   ASSERT_EQ(msg->fields->fields[1]->next->next, field1);
-   ASSERT_EQ(msg->fields->fields[1]->next->next->next, field);
-   ASSERT_EQ(msg->fields->fields[2], field4);
-   ASSERT_EQ(field4->descr->type->tag, 2);
-   ASSERT_EQ(field4->descr->category, FIXFieldCategory_Value);
-   ASSERT_TRUE(field4->next == NULL);
+   FIXField* field4 = fix_field_set(msg, NULL, &fields[4], (unsigned char const*)&val4, sizeof(val4), &error);
+   ASSERT_EQ(msg->fields->fields[4], field4);
    ASSERT_EQ(*(long*)field4->data, val4);
 
    ASSERT_EQ(fix_field_get(msg, msg->fields, 1), field);
-   ASSERT_EQ(fix_field_get(msg, msg->fields, 129), field2);
-   ASSERT_EQ(fix_field_get(msg, msg->fields, 193), field3);
+   ASSERT_EQ(fix_field_get(msg, msg->fields, 65), field1);
+   ASSERT_EQ(fix_field_get(msg, NULL, 129), field2);
+   ASSERT_EQ(fix_field_get(msg, NULL, 193), field3);
    ASSERT_EQ(fix_field_get(msg, msg->fields, 2), field4);
+   ASSERT_EQ(fix_field_get_by_descr(msg, NULL, &fields[3]), field3);
 
-   ASSERT_TRUE(fix_field_get(msg, msg->fields, 3) == NULL);
+   ASSERT_TRUE(fix_field_get(msg, msg->fields, 3) == NULL); // described, but not set
+   ASSERT_TRUE(fix_field_get(msg, msg->fields, 4) == NULL); // not described
 
    fix_parser_free(parser);
    free(msg);
@@ -298,25 +313,47 @@ TEST(FixFieldTests, AddGetDelGroupTest)
    FIXParser* parser = fix_parser_create("fix_descr/fix.4.4.xml", &attrs, PARSER_FLAG_CHECK_ALL, &error);
    ASSERT_TRUE(parser != NULL);
 
-   FIXMsg* msg = new_fake_message(parser);
+   FIXFieldDescr group_fields[] =
+   {
+      new_fdescr(2, FIXFieldCategory_Value, FIXFieldValueType_String),
+      new_fdescr(3, FIXFieldCategory_Value, FIXFieldValueType_String)
+   };
+   FIXFieldDescr fields[] =
+   {
+      new_fdescr(1, FIXFieldCategory_Group, FIXFieldValueType_NumInGroup)
+   };
+   set_group_fdescrs(&fields[0], group_fields, 2);
+   FIXMsg* msg = new_fake_message(parser, fields, 1);
+   ASSERT_EQ(msg->used_groups, msg->fields);
+   ASSERT_EQ(parser->used_groups, 1U);
 
    FIXField* field = NULL;
-   FIXGroup* grp = fix_group_add(msg, NULL, new_fdescr(1, FIXFieldCategory_Group, FIXFieldValueType_NumInGroup), &field, &error);
+   FIXGroup* grp = fix_group_add(msg, NULL, &fields[0], &field, &error);
    ASSERT_TRUE(field != NULL);
    ASSERT_TRUE(grp != NULL);
    ASSERT_EQ(field->size, 1U);
+   ASSERT_EQ(grp->parent_fdescr, &fields[0]);
+   ASSERT_EQ(grp->field_count, 2U);
+   ASSERT_EQ(grp->used[0], 0U);
    ASSERT_EQ(msg->used_groups, grp);
    ASSERT_EQ(parser->used_groups, 2U);
 
    long val = 100;
-   FIXField* field1 = fix_field_set(msg, NULL, new_fdescr(1, FIXFieldCategory_Value, FIXFieldValueType_String),
-         (unsigned char*)&val, sizeof(val), &error);
+   FIXFieldDescr value_fdescr = fields[0];
+   value_fdescr.category = FIXFieldCategory_Value;
+   FIXField* field1 = fix_field_set(msg, NULL, &value_fdescr, (unsigned char*)&val, sizeof(val), &error);
    ASSERT_TRUE(field1 == NULL);
    ASSERT_TRUE(error != NULL);
    ASSERT_EQ(error->code, FIX_ERROR_FIELD_HAS_WRONG_TYPE);
 
+   FIXField* grp_field = fix_field_set(msg, grp, &group_fields[1], (unsigned char*)&val, sizeof(val), &error);
+   ASSERT_EQ(grp->fields[1], grp_field);
+   ASSERT_EQ(fix_field_get(msg, grp, 3), grp_field);
+   ASSERT_TRUE(fix_field_get(msg, grp, 2) == NULL);
+   ASSERT_TRUE(fix_field_get(msg, NULL, 3) == NULL);
+
    FIXField* field11 = NULL;
-   FIXGroup* grp1 = fix_group_add(msg, NULL, new_fdescr(1, FIXFieldCategory_Group, FIXFieldValueType_NumInGroup), &field11, &error);
+   FIXGroup* grp1 = fix_group_add(msg, NULL, &fields[0], &field11, &error);
    ASSERT_TRUE(field11 != NULL);
    ASSERT_TRUE(grp1 != NULL);
    ASSERT_EQ(field11->size, 2U);
@@ -326,7 +363,7 @@ TEST(FixFieldTests, AddGetDelGroupTest)
    ASSERT_TRUE(parser->group == NULL);
 
    FIXField* field2 = NULL;
-   FIXGroup* grp2 = fix_group_add(msg, NULL, new_fdescr(1, FIXFieldCategory_Group, FIXFieldValueType_NumInGroup), &field2, &error);
+   FIXGroup* grp2 = fix_group_add(msg, NULL, &fields[0], &field2, &error);
    ASSERT_TRUE(field2 != NULL);
    ASSERT_TRUE(grp2 != NULL);
    ASSERT_EQ(field2->size, 3U);
@@ -337,13 +374,14 @@ TEST(FixFieldTests, AddGetDelGroupTest)
    ASSERT_TRUE(parser->group == NULL);
 
    FIXField* field3 = NULL;
-   FIXGroup* grp3 = fix_group_add(msg, NULL, new_fdescr(1, FIXFieldCategory_Group, FIXFieldValueType_NumInGroup), &field3, &error);
+   FIXGroup* grp3 = fix_group_add(msg, NULL, &fields[0], &field3, &error);
    ASSERT_TRUE(grp3 != NULL);
    ASSERT_EQ(field3->size, 4U);
    ASSERT_EQ(msg->used_groups, grp3);
    ASSERT_EQ(msg->used_groups->next, grp2);
    ASSERT_EQ(msg->used_groups->next->next, grp1);
    ASSERT_EQ(msg->used_groups->next->next->next, grp);
+   ASSERT_EQ(msg->used_groups->next->next->next->next, msg->fields);
    ASSERT_EQ(parser->used_groups, 5U);
    ASSERT_TRUE(parser->group == NULL);
 
@@ -373,7 +411,7 @@ TEST(FixFieldTests, AddGetDelGroupTest)
    ASSERT_EQ(msg->used_groups, grp2);
    ASSERT_EQ(msg->used_groups->next, grp1);
    ASSERT_EQ(msg->used_groups->next->next, grp);
-   ASSERT_TRUE(msg->used_groups->next->next->next == NULL);
+   ASSERT_EQ(msg->used_groups->next->next->next, msg->fields);
 
    ASSERT_TRUE(field->size == 3);
    ASSERT_TRUE(grps->group[0] == grp);
@@ -387,7 +425,7 @@ TEST(FixFieldTests, AddGetDelGroupTest)
    ASSERT_TRUE(parser->group->next->next == NULL);
    ASSERT_EQ(msg->used_groups, grp2);
    ASSERT_EQ(msg->used_groups->next, grp);
-   ASSERT_TRUE(msg->used_groups->next->next == NULL);
+   ASSERT_EQ(msg->used_groups->next->next, msg->fields);
 
    ASSERT_EQ(field->size, 2U);
    ASSERT_EQ(grps->group[0], grp);
@@ -400,7 +438,7 @@ TEST(FixFieldTests, AddGetDelGroupTest)
    ASSERT_EQ(parser->group->next, grp1);
    ASSERT_EQ(parser->group->next->next, grp3);
    ASSERT_EQ(msg->used_groups, grp2);
-   ASSERT_TRUE(msg->used_groups->next == NULL);
+   ASSERT_EQ(msg->used_groups->next, msg->fields);
 
    ASSERT_TRUE(field->size == 1);
    ASSERT_EQ(grps->group[0], grp2);
@@ -414,7 +452,8 @@ TEST(FixFieldTests, AddGetDelGroupTest)
    ASSERT_EQ(parser->group->next, grp);
    ASSERT_EQ(parser->group->next->next, grp1);
    ASSERT_EQ(parser->group->next->next->next, grp3);
-   ASSERT_TRUE(msg->used_groups == NULL);
+   ASSERT_EQ(msg->used_groups, msg->fields);
+   ASSERT_TRUE(msg->used_groups->next == NULL);
 
    fix_parser_free(parser);
    free(msg);
@@ -427,10 +466,30 @@ TEST(FixFieldTests, NestedGroupsTest)
    FIXParser* parser = fix_parser_create("fix_descr/fix.4.4.xml", &attrs, PARSER_FLAG_CHECK_ALL, &error);
    ASSERT_TRUE(parser != NULL);
 
-   FIXMsg* msg = new_fake_message(parser);
+   FIXFieldDescr nested_fields1[] =
+   {
+      new_fdescr(132, FIXFieldCategory_Value, FIXFieldValueType_String)
+   };
+   FIXFieldDescr nested_fields[] =
+   {
+      new_fdescr(131, FIXFieldCategory_Group, FIXFieldValueType_NumInGroup)
+   };
+   set_group_fdescrs(&nested_fields[0], nested_fields1, 1);
+   FIXFieldDescr group_fields[] =
+   {
+      new_fdescr(2, FIXFieldCategory_Value, FIXFieldValueType_String),
+      new_fdescr(65, FIXFieldCategory_Group, FIXFieldValueType_NumInGroup)
+   };
+   set_group_fdescrs(&group_fields[1], nested_fields, 1);
+   FIXFieldDescr fields[] =
+   {
+      new_fdescr(1, FIXFieldCategory_Group, FIXFieldValueType_NumInGroup)
+   };
+   set_group_fdescrs(&fields[0], group_fields, 2);
+   FIXMsg* msg = new_fake_message(parser, fields, 1);
 
    FIXField* field = NULL;
-   FIXGroup* grp = fix_group_add(msg, NULL, new_fdescr(1, FIXFieldCategory_Group, FIXFieldValueType_NumInGroup), &field, &error);
+   FIXGroup* grp = fix_group_add(msg, NULL, &fields[0], &field, &error);
    ASSERT_TRUE(field != NULL);
    ASSERT_TRUE(grp != NULL);
    ASSERT_EQ(field->size, 1U);
@@ -438,37 +497,42 @@ TEST(FixFieldTests, NestedGroupsTest)
    ASSERT_EQ(parser->used_groups, 2U);
 
    FIXField* nested_field = NULL;
-   FIXGroup* nested_grp = fix_group_add(msg, grp, new_fdescr(65, FIXFieldCategory_Group, FIXFieldValueType_NumInGroup), &nested_field, &error);
+   FIXGroup* nested_grp = fix_group_add(msg, grp, &group_fields[1], &nested_field, &error);
    ASSERT_TRUE(nested_field != NULL);
    ASSERT_TRUE(nested_grp != NULL);
+   ASSERT_EQ(grp->fields[1], nested_field);
    ASSERT_EQ(nested_field->descr->category, FIXFieldCategory_Group);
+   ASSERT_EQ(nested_grp->field_count, 1U);
    ASSERT_EQ(parser->used_groups, 3U);
 
    ASSERT_EQ(msg->used_groups, nested_grp);
    ASSERT_EQ(msg->used_groups->next, grp);
-   ASSERT_TRUE(msg->used_groups->next->next == NULL);
+   ASSERT_EQ(msg->used_groups->next->next, msg->fields);
 
    FIXField* nested_field1 = NULL;
-   FIXGroup* nested_grp1 = fix_group_add(msg, nested_grp, new_fdescr(131, FIXFieldCategory_Group, FIXFieldValueType_NumInGroup), &nested_field1, &error);
+   FIXGroup* nested_grp1 = fix_group_add(msg, nested_grp, &nested_fields[0], &nested_field1, &error);
    ASSERT_TRUE(nested_field1 != NULL);
    ASSERT_TRUE(nested_grp1 != NULL);
+   ASSERT_EQ(nested_grp->fields[0], nested_field1);
    ASSERT_EQ(nested_field1->descr->category, FIXFieldCategory_Group);
    ASSERT_EQ(parser->used_groups, 4U);
 
    ASSERT_EQ(msg->used_groups, nested_grp1);
    ASSERT_EQ(msg->used_groups->next, nested_grp);
    ASSERT_EQ(msg->used_groups->next->next, grp);
-   ASSERT_TRUE(msg->used_groups->next->next->next == NULL);
+   ASSERT_EQ(msg->used_groups->next->next->next, msg->fields);
 
    ASSERT_EQ(fix_group_del(msg, nested_grp, 131, 0, &error), FIX_SUCCESS);
+   ASSERT_TRUE(nested_grp->fields[0] == NULL);
 
    ASSERT_EQ(msg->used_groups, nested_grp);
    ASSERT_EQ(msg->used_groups->next, grp);
-   ASSERT_TRUE(msg->used_groups->next->next == NULL);
+   ASSERT_EQ(msg->used_groups->next->next, msg->fields);
    ASSERT_EQ(parser->group, nested_grp1);
 
    ASSERT_EQ(fix_group_del(msg, NULL, 1, 0, &error), FIX_SUCCESS);
-   ASSERT_TRUE(msg->used_groups == NULL);
+   ASSERT_EQ(msg->used_groups, msg->fields);
+   ASSERT_TRUE(msg->fields->fields[0] == NULL);
    ASSERT_EQ(parser->group, grp);
    ASSERT_EQ(parser->group->next, nested_grp);
    ASSERT_EQ(parser->group->next->next, nested_grp1);
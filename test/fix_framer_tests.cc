@@ -0,0 +1,167 @@
+/**
+ * @file   fix_framer_tests.cc
+ * @date   Created on: 10/17/2026 11:02:15 AM
+ */
+
+#include <fix_framer.h>
+#include <fix_parser.h>
+#include <fix_error.h>
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+static char const msg1[] =
+   "8=FIX.4.4|9=228|35=8|49=QWERTY_12345678|56=ABCQWE_XYZ|34=34|57=srv-ivanov_ii1|52=20120716-06:00:16.230|37=1|"
+   "11=CL_ORD_ID_1234567|17=FE_1_9494_1|150=0|39=1|1=ZUM|55=RTS-12.12|54=1|38=25|44=135155|59=0|32=0|31=0|151=25|"
+   "14=0|6=0|21=1|58=COMMENT12|10=110|";
+static char const msg2[] = "8=FIX.4.4|9=5|35=0|10=020|";
+
+//-------------------------------------------------------------------------------------------------------------------//
+TEST(FixFramerTests, CompleteMessagesTest)
+{
+   FIXError* error = NULL;
+   FIXFramer* framer = fix_framer_create('|', 0);
+   ASSERT_TRUE(framer != NULL);
+
+   std::string buff = std::string(msg1) + msg2;
+   uint32_t msgLen = 0;
+   ASSERT_EQ(fix_framer_next(framer, buff.data(), buff.size(), &msgLen, &error), FIX_SUCCESS);
+   ASSERT_EQ(msgLen, strlen(msg1));
+   ASSERT_EQ(fix_framer_next(framer, buff.data() + msgLen, buff.size() - msgLen, &msgLen, &error), FIX_SUCCESS);
+   ASSERT_EQ(msgLen, strlen(msg2));
+   ASSERT_EQ(fix_framer_next(framer, buff.data() + buff.size(), 0, &msgLen, &error), FIX_ERROR_NO_MORE_DATA);
+   ASSERT_TRUE(error == NULL);
+
+   fix_framer_free(framer);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+TEST(FixFramerTests, PartialReadsTest)
+{
+   FIXError* error = NULL;
+   FIXFramer* framer = fix_framer_create('|', 0);
+   ASSERT_TRUE(framer != NULL);
+
+   std::string stream = std::string(msg1) + msg2 + msg1;
+   for(uint32_t chunk = 1; chunk < 40; ++chunk)
+   {
+      std::string buff;
+      std::vector<std::string> msgs;
+      for(uint32_t pos = 0; pos < stream.size(); pos += chunk)
+      {
+         buff.append(stream, pos, chunk);
+         uint32_t msgLen = 0;
+         FIXErrCode res = FIX_SUCCESS;
+         while((res = fix_framer_next(framer, buff.data(), buff.size(), &msgLen, &error)) == FIX_SUCCESS)
+         {
+            msgs.push_back(buff.substr(0, msgLen));
+            buff.erase(0, msgLen);
+         }
+         ASSERT_EQ(res, FIX_ERROR_NO_MORE_DATA);
+         ASSERT_TRUE(error == NULL);
+      }
+      ASSERT_TRUE(buff.empty());
+      ASSERT_EQ(msgs.size(), 3U);
+      ASSERT_EQ(msgs[0], msg1);
+      ASSERT_EQ(msgs[1], msg2);
+      ASSERT_EQ(msgs[2], msg1);
+   }
+
+   fix_framer_free(framer);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+TEST(FixFramerTests, WrongDataTest)
+{
+   FIXError* error = NULL;
+   FIXFramer* framer = fix_framer_create('|', 100);
+   ASSERT_TRUE(framer != NULL);
+
+   char const* wrong[] = {
+      "9=5|35=0|10=161|",
+      "8=FIX.4.4|35=0|9=5|10=161|",
+      "8=FIX.4.4|9=5A|35=0|10=161|",
+      "8=FIX.4.4|9=|35=0|10=161|",
+      "8=FIX.4.4|9=6|35=0|10=161|",
+      "8=FIX.4.4|9=5|35=0|11=161|",
+      "8=FIX.4.4|9=228|35=8|"};
+   for(uint32_t i = 0; i < sizeof(wrong) / sizeof(wrong[0]); ++i)
+   {
+      uint32_t msgLen = 0;
+      ASSERT_EQ(fix_framer_next(framer, wrong[i], strlen(wrong[i]), &msgLen, &error), FIX_FAILED) << wrong[i];
+      ASSERT_TRUE(error != NULL);
+      fix_error_free(error);
+      error = NULL;
+      fix_framer_reset(framer);
+   }
+   fix_framer_free(framer);
+
+   // maxMsgLen covers CheckSum field, whose value is exactly three digits
+   framer = fix_framer_create('|', 20);
+   ASSERT_TRUE(framer != NULL);
+   char const* tooLong[] = {
+      "8=FIX.4.4|9=5|35=0|10=020|",
+      "8=FIX.4.4|9=5|35=0|10=0000000000000000000000000000000000000000000000000000000020|"};
+   for(uint32_t i = 0; i < sizeof(tooLong) / sizeof(tooLong[0]); ++i)
+   {
+      uint32_t msgLen = 0;
+      ASSERT_EQ(fix_framer_next(framer, tooLong[i], strlen(tooLong[i]), &msgLen, &error), FIX_FAILED) << tooLong[i];
+      ASSERT_TRUE(error != NULL);
+      fix_error_free(error);
+      error = NULL;
+      fix_framer_reset(framer);
+   }
+   fix_framer_free(framer);
+
+   char const exact[] = "8=FIX.4.4|9=5|35=0|10=020|";
+   framer = fix_framer_create('|', strlen(exact));
+   ASSERT_TRUE(framer != NULL);
+   uint32_t msgLen = 0;
+   ASSERT_EQ(fix_framer_next(framer, exact, strlen(exact), &msgLen, &error), FIX_SUCCESS);
+   ASSERT_EQ(msgLen, strlen(exact));
+
+   char const* badCheckSum[] = {
+      "8=FIX.4.4|9=5|35=0|10=0200|",
+      "8=FIX.4.4|9=5|35=0|10=02|",
+      "8=FIX.4.4|9=5|35=0|10=0A0|"};
+   for(uint32_t i = 0; i < sizeof(badCheckSum) / sizeof(badCheckSum[0]); ++i)
+   {
+      ASSERT_EQ(fix_framer_next(framer, badCheckSum[i], strlen(badCheckSum[i]), &msgLen, &error), FIX_FAILED) << badCheckSum[i];
+      ASSERT_EQ(fix_error_get_code(error), FIX_ERROR_INTEGRITY_CHECK) << badCheckSum[i];
+      fix_error_free(error);
+      error = NULL;
+      fix_framer_reset(framer);
+   }
+
+   // incomplete trailer is waited for
+   ASSERT_EQ(fix_framer_next(framer, exact, strlen(exact) - 1, &msgLen, &error), FIX_ERROR_NO_MORE_DATA);
+   ASSERT_EQ(fix_framer_next(framer, exact, strlen(exact), &msgLen, &error), FIX_SUCCESS);
+   ASSERT_EQ(msgLen, strlen(exact));
+   fix_framer_free(framer);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+TEST(FixFramerTests, ParseFramedTest)
+{
+   FIXError* error = NULL;
+   FIXParser* parser = fix_parser_create("fix_descr/fix.4.4.xml", NULL, PARSER_FLAG_CHECK_ALL, &error);
+   ASSERT_TRUE(parser != NULL);
+   FIXFramer* framer = fix_framer_create('|', 0);
+   ASSERT_TRUE(framer != NULL);
+
+   std::string buff(msg1, 100);
+   uint32_t msgLen = 0;
+   ASSERT_EQ(fix_framer_next(framer, buff.data(), buff.size(), &msgLen, &error), FIX_ERROR_NO_MORE_DATA);
+   buff.append(msg1 + 100);
+   ASSERT_EQ(fix_framer_next(framer, buff.data(), buff.size(), &msgLen, &error), FIX_SUCCESS);
+
+   char const* stop = NULL;
+   FIXMsg* msg = fix_parser_str_to_msg(parser, buff.data(), msgLen, '|', &stop, &error);
+   ASSERT_TRUE(msg != NULL);
+   ASSERT_EQ(stop, buff.data() + msgLen - 1);
+
+   fix_msg_free(msg);
+   fix_framer_free(framer);
+   fix_parser_free(parser);
+}
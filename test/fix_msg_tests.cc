@@ -10,6 +10,7 @@
 #include <fix_parser_priv.h>
 
 #include <gtest/gtest.h>
+#include <math.h>
 
 //-------------------------------------------------------------------------------------------------------------------//
 TEST(FixMsgTests, CreateMsgTest)
@@ -368,3 +369,154 @@ TEST(FixMsgTests, ToStringGroupTest2)
    ASSERT_TRUE(msg1 != NULL);
 }
 
+
+//-------------------------------------------------------------------------------------------------------------------//
+static uint32_t used_space(FIXMsg const* msg)
+{
+   uint32_t used = 0;
+   for(FIXPage const* page = msg->pages; page; page = page->next)
+   {
+      used += page->offset;
+   }
+   return used;
+}
+
+TEST(FixMsgTests, ReuseFreeSpaceTest)
+{
+   FIXError* error = NULL;
+   FIXParserAttrs attrs = {512, 0, 2, 0, 2, 0};
+   FIXParser* p = fix_parser_create("fix_descr/fix.4.4.xml", &attrs, PARSER_FLAG_CHECK_ALL, &error);
+   ASSERT_TRUE(p != NULL);
+
+   FIXMsg* msg = fix_msg_create(p, "D", &error);
+   ASSERT_TRUE(msg != NULL);
+   ASSERT_EQ(FIX_SUCCESS, fix_msg_set_string(msg, NULL, FIXFieldTag_ClOrdID, "CL_ORD_ID_1", &error));
+
+   // grown field keeps old content and releases old block
+   char const* val = NULL;
+   uint32_t len = 0;
+   FIXField* field = fix_msg_get_field(msg, NULL, FIXFieldTag_ClOrdID);
+   char* old_data = field->data;
+   ASSERT_EQ(FIX_SUCCESS, fix_msg_set_string(msg, NULL, FIXFieldTag_ClOrdID, "CL_ORD_ID_1234567", &error));
+   ASSERT_TRUE(field->data != old_data);
+   ASSERT_NE(msg->free_mask, 0U);
+   ASSERT_EQ(0U, (uintptr_t)old_data % 8); // released block holds free list link
+   ASSERT_EQ(FIX_SUCCESS, fix_msg_get_string(msg, NULL, FIXFieldTag_ClOrdID, &val, &len, &error));
+   ASSERT_EQ(0, strncmp(val, "CL_ORD_ID_1234567", len));
+
+   // template message updated again and again stops growing
+   uint32_t used = 0;
+   char text[64];
+   for(int32_t i = 0; i < 100; ++i)
+   {
+      snprintf(text, sizeof(text), "%.*s", 10 + i % 40, "0123456789012345678901234567890123456789012345678901234567890");
+      ASSERT_EQ(FIX_SUCCESS, fix_msg_set_string(msg, NULL, FIXFieldTag_Text, text, &error));
+      ASSERT_EQ(FIX_SUCCESS, fix_msg_set_string(msg, NULL, FIXFieldTag_SendingTime, i % 2 ? "20120716-06:00:16" :
+               "20120716-06:00:16.230", &error));
+      for(int32_t j = 0; j < 3; ++j)
+      {
+         FIXGroup* grp = fix_msg_add_group(msg, NULL, FIXFieldTag_NoPartyIDs, &error);
+         ASSERT_TRUE(grp != NULL);
+         ASSERT_EQ(FIX_SUCCESS, fix_msg_set_string(msg, grp, FIXFieldTag_PartyID, "PARTY", &error));
+      }
+      ASSERT_EQ(FIX_SUCCESS, fix_msg_del_field(msg, NULL, FIXFieldTag_NoPartyIDs, &error));
+      if (i == 50)
+      {
+         used = used_space(msg);
+      }
+      else if (i > 50)
+      {
+         ASSERT_EQ(used, used_space(msg));
+      }
+   }
+   ASSERT_EQ(FIX_SUCCESS, fix_msg_get_string(msg, NULL, FIXFieldTag_Text, &val, &len, &error));
+   ASSERT_EQ(0, strncmp(val, text, len));
+   ASSERT_EQ(0U, (uintptr_t)val % 8); // blocks are aligned whether taken from page or free list
+
+   // reset drops free lists with pages content
+   ASSERT_EQ(FIX_SUCCESS, fix_msg_reset(msg, &error));
+   ASSERT_EQ(msg->free_mask, 0U);
+
+   fix_msg_free(msg);
+   fix_parser_free(p);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+TEST(FixMsgTests, SetDoubleTest)
+{
+   FIXError* error = NULL;
+   FIXParserAttrs attrs = {512, 0, 2, 0, 2, 0};
+   FIXParser* p = fix_parser_create("fix_descr/fix.4.4.xml", &attrs, PARSER_FLAG_CHECK_ALL, &error);
+   ASSERT_TRUE(p != NULL);
+
+   FIXMsg* msg = fix_msg_create(p, "D", &error);
+   ASSERT_TRUE(msg != NULL);
+
+   char const* val = NULL;
+   uint32_t len = 0;
+   ASSERT_EQ(fix_msg_set_double(msg, NULL, FIXFieldTag_Price, 0.1 + 0.2, &error), FIX_SUCCESS);
+   ASSERT_EQ(fix_msg_get_string(msg, NULL, FIXFieldTag_Price, &val, &len, &error), FIX_SUCCESS);
+   ASSERT_EQ(std::string(val, len), "0.30000000000000004");
+
+   ASSERT_EQ(fix_msg_set_double_fixed(msg, NULL, FIXFieldTag_Price, 0.1 + 0.2, 2, &error), FIX_SUCCESS);
+   ASSERT_EQ(fix_msg_get_string(msg, NULL, FIXFieldTag_Price, &val, &len, &error), FIX_SUCCESS);
+   ASSERT_EQ(std::string(val, len), "0.30");
+
+   ASSERT_EQ(fix_msg_set_double_fixed(msg, NULL, FIXFieldTag_Price, 135.15, 18, &error), FIX_FAILED);
+   ASSERT_EQ(error->code, FIX_ERROR_INVALID_ARGUMENT);
+   fix_error_free(error);
+
+   ASSERT_EQ(fix_msg_set_double(msg, NULL, FIXFieldTag_Price, HUGE_VAL, &error), FIX_FAILED);
+   ASSERT_EQ(error->code, FIX_ERROR_WRONG_FIELD_VALUE);
+   fix_error_free(error);
+
+   fix_msg_free(msg);
+   fix_parser_free(p);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+TEST(FixMsgTests, DecimalTest)
+{
+   FIXError* error = NULL;
+   FIXParserAttrs attrs = {512, 0, 2, 0, 2, 0};
+   FIXParser* p = fix_parser_create("fix_descr/fix.4.4.xml", &attrs, PARSER_FLAG_CHECK_ALL, &error);
+   ASSERT_TRUE(p != NULL);
+
+   FIXMsg* msg = fix_msg_create(p, "D", &error);
+   ASSERT_TRUE(msg != NULL);
+
+   char const* val = NULL;
+   uint32_t len = 0;
+   ASSERT_EQ(fix_msg_set_decimal(msg, NULL, FIXFieldTag_Price, 13510, -2, &error), FIX_SUCCESS);
+   ASSERT_EQ(fix_msg_get_string(msg, NULL, FIXFieldTag_Price, &val, &len, &error), FIX_SUCCESS);
+   ASSERT_EQ(std::string(val, len), "135.10");
+
+   int64_t mantissa = 0;
+   int32_t exponent = 0;
+   ASSERT_EQ(fix_msg_get_decimal(msg, NULL, FIXFieldTag_Price, &mantissa, &exponent, &error), FIX_SUCCESS);
+   ASSERT_EQ(mantissa, 13510);
+   ASSERT_EQ(exponent, -2);
+
+   ASSERT_EQ(fix_msg_set_double(msg, NULL, FIXFieldTag_OrderQty, 25, &error), FIX_SUCCESS);
+   ASSERT_EQ(fix_msg_get_decimal(msg, NULL, FIXFieldTag_OrderQty, &mantissa, &exponent, &error), FIX_SUCCESS);
+   ASSERT_EQ(mantissa, 25);
+   ASSERT_EQ(exponent, 0);
+
+   ASSERT_EQ(fix_msg_get_decimal(msg, NULL, FIXFieldTag_StopPx, &mantissa, &exponent, &error), FIX_NO_FIELD);
+
+   ASSERT_EQ(fix_msg_set_decimal(msg, NULL, FIXFieldTag_Price, 1, 19, &error), FIX_FAILED);
+   ASSERT_EQ(error->code, FIX_ERROR_INVALID_ARGUMENT);
+   fix_error_free(error);
+
+   ASSERT_EQ(fix_msg_set_decimal(msg, NULL, FIXFieldTag_ClOrdID, 1, 0, &error), FIX_FAILED);
+   ASSERT_EQ(error->code, FIX_ERROR_FIELD_HAS_WRONG_TYPE);
+   fix_error_free(error);
+
+   ASSERT_EQ(fix_msg_set_string(msg, NULL, FIXFieldTag_ClOrdID, "CL_ORD_ID_1", &error), FIX_SUCCESS);
+   ASSERT_EQ(fix_msg_get_decimal(msg, NULL, FIXFieldTag_ClOrdID, &mantissa, &exponent, &error), FIX_FAILED);
+   ASSERT_EQ(error->code, FIX_ERROR_FIELD_HAS_WRONG_TYPE);
+   fix_error_free(error);
+
+   fix_msg_free(msg);
+   fix_parser_free(p);
+}
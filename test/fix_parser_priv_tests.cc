@@ -6,6 +6,7 @@
 
 #include <fix_parser.h>
 #include <fix_parser_priv.h>
+#include <fix_utils.h>
 
 #include <gtest/gtest.h>
 
@@ -158,6 +159,366 @@ TEST(FixParserPrivTests, MaxGroupsTest)
    fix_parser_free(parser);
 }
 
+TEST(FixParserPrivTests, MaxMsgsTest)
+{
+   FIXError* error = NULL;
+   FIXParserAttrs attrs = {512, 0, 2, 0, 2, 0, 2, 2};
+   FIXParser* parser = fix_parser_create("fix_descr/fix.4.4.xml", &attrs, PARSER_FLAG_CHECK_ALL, &error);
+   ASSERT_TRUE(parser != NULL);
+   ASSERT_EQ(parser->used_msgs, 0U);
+
+   FIXMsg* m1 = fix_msg_create(parser, "A", &error);
+   ASSERT_TRUE(m1 != NULL);
+   ASSERT_TRUE(m1->next == NULL);
+   ASSERT_EQ(parser->used_msgs, 1U);
+
+   FIXMsg* m2 = fix_msg_create(parser, "0", &error);
+   ASSERT_TRUE(m2 != NULL);
+   ASSERT_TRUE(parser->msg == NULL);
+   ASSERT_EQ(parser->used_msgs, 2U);
+
+   FIXMsg* m3 = fix_msg_create(parser, "0", &error);
+   ASSERT_TRUE(m3 == NULL);
+   ASSERT_EQ(error->code, FIX_ERROR_NO_MORE_MSGS);
+   ASSERT_EQ(parser->used_msgs, 2U);
+
+   fix_msg_free(m1);
+   ASSERT_EQ(parser->msg, m1);
+   ASSERT_EQ(parser->used_msgs, 1U);
+
+   m3 = fix_msg_create(parser, "0", &error);
+   ASSERT_EQ(m3, m1);
+   ASSERT_TRUE(parser->msg == NULL);
+   ASSERT_EQ(parser->used_msgs, 2U);
+
+   fix_msg_free(m2);
+   fix_msg_free(m3);
+   ASSERT_EQ(parser->used_msgs, 0U);
+
+   fix_parser_free(parser);
+}
+
+TEST(FixParserPrivTests, SlabPoolTest)
+{
+   FIXError* error = NULL;
+   FIXParserAttrs attrs = {512, 0, 3, 0, 2, 0, 2, 0, POOL_FLAG_HUGE_PAGES | POOL_FLAG_PREFAULT};
+   FIXParser* parser = fix_parser_create("fix_descr/fix.4.4.xml", &attrs, PARSER_FLAG_CHECK_ALL, &error);
+   ASSERT_TRUE(parser != NULL);
+   ASSERT_TRUE(parser->slab != NULL);
+   ASSERT_EQ(parser->slab_size % 4096, 0U);
+
+   // pages are taken from slab in ascending address order
+   FIXPage* p1 = fix_parser_alloc_page(parser, 0, &error);
+   FIXPage* p2 = fix_parser_alloc_page(parser, 0, &error);
+   FIXPage* p3 = fix_parser_alloc_page(parser, 0, &error);
+   ASSERT_EQ(p1, (FIXPage*)parser->slab);
+   ASSERT_TRUE(p1 < p2 && p2 < p3);
+   ASSERT_EQ((uintptr_t)p2 % 64, 0U);
+   ASSERT_EQ(p3->size, 512U);
+   ASSERT_TRUE(parser->page == NULL);
+
+   FIXGroup* g = fix_parser_alloc_group(parser, &error);
+   ASSERT_TRUE((char*)g > (char*)p3 && (char*)g < parser->slab + parser->slab_size);
+
+   // pool is exhausted, next page comes from heap and is freed with parser
+   FIXPage* p4 = fix_parser_alloc_page(parser, 0, &error);
+   ASSERT_TRUE((char*)p4 < parser->slab || (char*)p4 >= parser->slab + parser->slab_size);
+   fix_parser_free_page(parser, p4);
+   fix_parser_free_page(parser, p3);
+   fix_parser_free_page(parser, p2);
+   fix_parser_free_page(parser, p1);
+   fix_parser_free_group(parser, g);
+
+   FIXMsg* msg = fix_msg_create(parser, "D", &error);
+   ASSERT_TRUE(msg != NULL);
+   ASSERT_EQ(FIX_SUCCESS, fix_msg_set_string(msg, NULL, FIXFieldTag_ClOrdID, "CL_ORD_ID_1234567", &error));
+   fix_msg_free(msg);
+
+   fix_parser_free(parser);
+
+   attrs.poolFlags = 0x100;
+   ASSERT_TRUE(fix_parser_create("fix_descr/fix.4.4.xml", &attrs, PARSER_FLAG_CHECK_ALL, &error) == NULL);
+   ASSERT_EQ(error->code, FIX_ERROR_INVALID_ARGUMENT);
+   fix_error_free(error);
+}
+
+TEST(FixParserPrivTests, NumaPoolTest)
+{
+   FIXError* error = NULL;
+   FIXParserAttrs attrs = {512, 0, 3, 0, 2, 0, 2, 0, POOL_FLAG_NUMA | POOL_FLAG_PREFAULT};
+   attrs.numaNode = 64;
+   ASSERT_TRUE(fix_parser_create("fix_descr/fix.4.4.xml", &attrs, PARSER_FLAG_CHECK_ALL, &error) == NULL);
+   ASSERT_EQ(error->code, FIX_ERROR_MALLOC);
+   fix_error_free(error);
+   error = NULL;
+
+   attrs.numaNode = 0; // node 0 exists on any machine
+   uint64_t size = 1;
+   void* probe = fix_utils_slab_alloc(&size, POOL_FLAG_NUMA, attrs.numaNode);
+   if (!probe) // memory policy is not supported by kernel or forbidden by sandbox
+   {
+      return;
+   }
+   fix_utils_slab_free(probe, size);
+   FIXParser* parser = fix_parser_create("fix_descr/fix.4.4.xml", &attrs, PARSER_FLAG_CHECK_ALL, &error);
+   ASSERT_TRUE(parser != NULL);
+   ASSERT_TRUE(parser->slab != NULL);
+   ASSERT_EQ(parser->page, (FIXPage*)parser->slab);
+
+   FIXMsg* msg = fix_msg_create(parser, "D", &error);
+   ASSERT_TRUE(msg != NULL);
+   ASSERT_EQ(FIX_SUCCESS, fix_msg_set_string(msg, NULL, FIXFieldTag_ClOrdID, "CL_ORD_ID_1234567", &error));
+   fix_msg_free(msg);
+   fix_parser_free(parser);
+}
+
+TEST(FixParserPrivTests, ArenaTest)
+{
+   FIXError* error = NULL;
+   FIXParserAttrs attrs = {4096, 0, 2, 0, 2, 0, 0, 0, 0, 8192};
+   FIXParser* parser = fix_parser_create("fix_descr/fix.4.4.xml", &attrs, PARSER_FLAG_CHECK_ALL, &error);
+   ASSERT_TRUE(parser != NULL);
+
+   // no statistics yet, messages share one arena block with default page size
+   FIXMsg* msgs[8];
+   for(uint32_t i = 0; i < 8; ++i)
+   {
+      msgs[i] = fix_msg_create(parser, "0", &error);
+      ASSERT_TRUE(msgs[i] != NULL);
+      ASSERT_TRUE(msgs[i]->pages->block != NULL);
+      ASSERT_EQ(msgs[i]->pages->block, msgs[0]->pages->block);
+      ASSERT_EQ(msgs[i]->pages->size, 512U);
+   }
+   FIXArenaBlock* block = msgs[0]->pages->block;
+   ASSERT_EQ(block->live, 8U);
+   ASSERT_EQ(parser->used_pages, 8U);
+
+   // growing message takes twice bigger page from arena
+   FIXMsg* req = fix_msg_create(parser, "1", &error);
+   ASSERT_TRUE(req != NULL);
+   char text[600];
+   memset(text, 'A', sizeof(text) - 1);
+   text[sizeof(text) - 1] = 0;
+   ASSERT_EQ(FIX_SUCCESS, fix_msg_set_string(req, NULL, FIXFieldTag_TestReqID, text, &error));
+   ASSERT_TRUE(req->pages->next != NULL);
+   ASSERT_EQ(req->pages->next->size, 1024U);
+   ASSERT_EQ(req->pages->next->block, parser->arena);
+   fix_msg_free(req);
+
+   for(uint32_t i = 0; i < 8; ++i)
+   {
+      fix_msg_free(msgs[i]);
+   }
+   ASSERT_EQ(parser->used_pages, 0U);
+   ASSERT_EQ(block->live, 0U);
+   ASSERT_TRUE(parser->free_blocks == block || parser->arena == block);
+
+   FIXMsgStats stats = {};
+   ASSERT_EQ(FIX_SUCCESS, fix_parser_get_msg_stats(parser, "1", &stats, &error));
+   ASSERT_EQ(stats.count, 1U);
+   ASSERT_TRUE(stats.maxSize > sizeof(text));
+   ASSERT_EQ(FIX_SUCCESS, fix_parser_get_msg_stats(parser, "0", &stats, &error));
+   ASSERT_EQ(stats.count, 8U);
+   ASSERT_TRUE(stats.avgSize <= stats.maxSize);
+
+   // next heartbeat gets page sized by statistics
+   FIXMsg* msg = fix_msg_create(parser, "0", &error);
+   ASSERT_TRUE(msg != NULL);
+   ASSERT_TRUE(msg->pages->size < 512U);
+   fix_msg_free(msg);
+
+   ASSERT_EQ(FIX_FAILED, fix_parser_get_msg_stats(parser, "ZZZ", &stats, &error));
+   ASSERT_EQ(error->code, FIX_ERROR_UNKNOWN_MSG);
+   fix_error_free(error);
+
+   fix_parser_free(parser);
+}
+
+TEST(FixParserPrivTests, StatsTrimTest)
+{
+   FIXError* error = NULL;
+   FIXParserAttrs attrs = {512, 0, 2, 0, 2, 0, 2, 3};
+   FIXParser* parser = fix_parser_create("fix_descr/fix.4.4.xml", &attrs, PARSER_FLAG_CHECK_ALL, &error);
+   ASSERT_TRUE(parser != NULL);
+   ASSERT_EQ(fix_parser_get_stats(parser, NULL), FIX_FAILED);
+
+   FIXParserStats stats;
+   ASSERT_EQ(fix_parser_get_stats(parser, &stats), FIX_SUCCESS);
+   ASSERT_EQ(stats.msgs.used, 0U);
+   ASSERT_EQ(stats.msgs.free, 2U);
+   ASSERT_EQ(stats.pages.free, 2U);
+   ASSERT_EQ(stats.groups.free, 2U);
+
+   FIXMsg* msgs[3] = {};
+   for(int i = 0; i < 3; ++i)
+   {
+      msgs[i] = fix_msg_create(parser, "0", &error);
+      ASSERT_TRUE(msgs[i] != NULL);
+   }
+   ASSERT_TRUE(fix_msg_create(parser, "0", &error) == NULL);
+   ASSERT_EQ(error->code, FIX_ERROR_NO_MORE_MSGS);
+   fix_error_free(error);
+
+   ASSERT_EQ(fix_parser_get_stats(parser, &stats), FIX_SUCCESS);
+   ASSERT_EQ(stats.msgs.used, 3U);
+   ASSERT_EQ(stats.msgs.peak, 3U);
+   ASSERT_EQ(stats.msgs.free, 0U);
+   ASSERT_EQ(stats.msgs.overflows, 1U);
+   ASSERT_EQ(stats.msgs.failures, 1U);
+   ASSERT_EQ(stats.pages.used, 3U);
+   ASSERT_EQ(stats.pages.overflows, 1U);
+   ASSERT_EQ(stats.groups.used, 3U);
+   ASSERT_EQ(stats.groups.overflows, 1U);
+
+   for(int i = 0; i < 3; ++i)
+   {
+      fix_msg_free(msgs[i]);
+   }
+   ASSERT_EQ(fix_parser_get_stats(parser, &stats), FIX_SUCCESS);
+   ASSERT_EQ(stats.msgs.used, 0U);
+   ASSERT_EQ(stats.msgs.peak, 3U);
+   ASSERT_EQ(stats.msgs.free, 3U);
+   ASSERT_EQ(stats.pages.free, 3U);
+   ASSERT_EQ(stats.groups.free, 3U);
+
+   // back to preallocated size
+   ASSERT_EQ(fix_parser_trim(parser, attrs.numPages, attrs.numGroups, attrs.numMsgs), FIX_SUCCESS);
+   ASSERT_EQ(fix_parser_get_stats(parser, &stats), FIX_SUCCESS);
+   ASSERT_EQ(stats.msgs.free, 2U);
+   ASSERT_EQ(stats.pages.free, 2U);
+   ASSERT_EQ(stats.groups.free, 2U);
+
+   FIXMsg* msg = fix_msg_create(parser, "0", &error);
+   ASSERT_TRUE(msg != NULL);
+   ASSERT_EQ(fix_parser_trim(parser, 0, 0, 0), FIX_SUCCESS);
+   ASSERT_EQ(fix_parser_get_stats(parser, &stats), FIX_SUCCESS);
+   ASSERT_EQ(stats.msgs.used, 1U);
+   ASSERT_EQ(stats.msgs.free, 0U);
+   ASSERT_EQ(stats.pages.free, 0U);
+   ASSERT_EQ(stats.groups.free, 0U);
+   fix_msg_free(msg);
+
+   fix_parser_free(parser);
+}
+
+struct CountingAllocator
+{
+   int32_t allocs;
+   int32_t frees;
+};
+
+static void* counting_alloc(void* ctx, size_t size)
+{
+   ++((CountingAllocator*)ctx)->allocs;
+   return malloc(size);
+}
+
+static void counting_free(void* ctx, void* ptr)
+{
+   ++((CountingAllocator*)ctx)->frees;
+   free(ptr);
+}
+
+TEST(FixParserPrivTests, AllocatorTest)
+{
+   FIXError* error = NULL;
+   CountingAllocator counter = {};
+   FIXParserAttrs attrs = {512, 0, 2, 0, 2, 0, 2, 0};
+   attrs.allocator.alloc = &counting_alloc;
+   attrs.allocator.ctx = &counter;
+   FIXParser* parser = fix_parser_create("fix_descr/fix.4.4.xml", &attrs, PARSER_FLAG_CHECK_ALL, &error);
+   ASSERT_TRUE(parser == NULL);
+   ASSERT_EQ(error->code, FIX_ERROR_INVALID_ARGUMENT);
+   fix_error_free(error);
+   ASSERT_EQ(counter.allocs, 0);
+
+   attrs.allocator.free = &counting_free;
+   parser = fix_parser_create("fix_descr/fix.4.4.xml", &attrs, PARSER_FLAG_CHECK_ALL, &error);
+   ASSERT_TRUE(parser != NULL);
+   int32_t const created = counter.allocs;
+   ASSERT_GT(created, 0);
+
+   FIXMsg* msgs[4] = {};
+   for(int i = 0; i < 4; ++i)
+   {
+      msgs[i] = fix_msg_create(parser, "0", &error);
+      ASSERT_TRUE(msgs[i] != NULL);
+   }
+   ASSERT_GT(counter.allocs, created); // pools grew
+   for(int i = 0; i < 4; ++i)
+   {
+      fix_msg_free(msgs[i]);
+   }
+
+   fix_parser_free(parser);
+   ASSERT_EQ(counter.allocs, counter.frees);
+}
+
+struct FailingAllocator
+{
+   int32_t allocs;
+   int32_t frees;
+   int32_t limit; ///< allocations which succeed before the first failure
+};
+
+static void* failing_alloc(void* ctx, size_t size)
+{
+   FailingAllocator* failing = (FailingAllocator*)ctx;
+   if (failing->allocs == failing->limit)
+   {
+      return NULL;
+   }
+   ++failing->allocs;
+   return malloc(size);
+}
+
+static void failing_free(void* ctx, void* ptr)
+{
+   ++((FailingAllocator*)ctx)->frees;
+   free(ptr);
+}
+
+TEST(FixParserPrivTests, AllocFailureTest)
+{
+   FIXError* error = NULL;
+   FailingAllocator failing = {};
+   FIXParserAttrs attrs = {512, 0, 2, 0, 2, 0, 2, 0};
+   attrs.allocator.alloc = &failing_alloc;
+   attrs.allocator.free = &failing_free;
+   attrs.allocator.ctx = &failing;
+   FIXParser* parser = NULL;
+   for(; !parser; ++failing.limit) // fail each allocation in turn until creation succeeds
+   {
+      failing.allocs = failing.frees = 0;
+      parser = fix_parser_create("test_data/fix1.xml", &attrs, PARSER_FLAG_CHECK_ALL, &error);
+      if (!parser)
+      {
+         ASSERT_EQ(error->code, FIX_ERROR_MALLOC);
+         fix_error_free(error);
+         error = NULL;
+         ASSERT_EQ(failing.allocs, failing.frees);
+      }
+   }
+   ASSERT_GT(failing.limit, 10);
+
+   FIXTagNum const tags[] = {37};
+   failing.limit = failing.allocs; // mask
+   ASSERT_EQ(FIX_FAILED, fix_parser_set_projection(parser, "8", tags, 1, &error));
+   ASSERT_EQ(error->code, FIX_ERROR_MALLOC);
+   fix_error_free(error);
+   error = NULL;
+   failing.limit = failing.allocs + 1; // projection
+   ASSERT_EQ(FIX_FAILED, fix_parser_set_projection(parser, "8", tags, 1, &error));
+   ASSERT_EQ(error->code, FIX_ERROR_MALLOC);
+   fix_error_free(error);
+   error = NULL;
+   failing.limit = -1;
+   ASSERT_EQ(FIX_SUCCESS, fix_parser_set_projection(parser, "8", tags, 1, &error));
+
+   fix_parser_free(parser);
+   ASSERT_EQ(failing.allocs, failing.frees);
+}
+
 TEST(FixParserPrivTests, MaxPageSizeTest)
 {
    {
@@ -9,6 +9,9 @@
 #include <fix_msg.h>
 
 #include <gtest/gtest.h>
+#ifndef WIN32
+#  include <pthread.h>
+#endif
 
 //-------------------------------------------------------------------------------------------------------------------//
 TEST(FixParserTests, ParseFieldTest)
@@ -405,6 +408,39 @@ TEST(FixParserTests, ParseStringTest)
    ASSERT_STREQ(buff, buff1); // Bingo!
 }
 
+//-------------------------------------------------------------------------------------------------------------------//
+TEST(FixParserTests, ParseLongPriceTest)
+{
+   FIXError* error = NULL;
+   FIXParser* parser = fix_parser_create("fix_descr/fix.4.4.xml", NULL, PARSER_FLAG_CHECK_ALL, &error);
+   ASSERT_TRUE(parser != NULL);
+   char buff[] = "8=FIX.4.4\0019=245\00135=8\00149=QWERTY_12345678\00156=ABCQWE_XYZ\00134=34\00157=srv-ivanov_ii1\00152=20120716-06:00:16.230\00137=1\001"
+      "11=CL_ORD_ID_1234567\00117=FE_1_9494_1\001150=0\00139=1\0011=ZUM\00155=RTS-12.12\00154=1\00138=25\00144=1.234567890123456789012\00159=0\00132=0\001"
+      "31=0\001151=25\00114=0\0016=0\00121=1\00158=COMMENT12\00110=102\001";
+   char const* stop = NULL;
+   FIXMsg* msg = fix_parser_str_to_msg(parser, buff, strlen(buff), FIX_SOH, &stop, &error);
+   ASSERT_TRUE(msg != NULL);
+
+   double price = 0.0;
+   ASSERT_EQ(FIX_SUCCESS, fix_msg_get_double(msg, NULL, FIXFieldTag_Price, &price, &error));
+   ASSERT_DOUBLE_EQ(1.234567890123456789012, price);
+
+   int64_t mantissa = 0;
+   int32_t exponent = 0;
+   ASSERT_EQ(FIX_FAILED, fix_msg_get_decimal(msg, NULL, FIXFieldTag_Price, &mantissa, &exponent, &error));
+   fix_error_free(error);
+   error = NULL;
+
+   char buff1[1024];
+   uint32_t reqBuffLen = 0;
+   ASSERT_EQ(FIX_SUCCESS, fix_msg_to_str(msg, FIX_SOH, buff1, sizeof(buff1), &reqBuffLen, &error));
+   buff1[reqBuffLen] = 0;
+   ASSERT_STREQ(buff, buff1);
+
+   fix_msg_free(msg);
+   fix_parser_free(parser);
+}
+
 //-------------------------------------------------------------------------------------------------------------------//
 TEST(FixParserTests, ParseMultipleStringTest)
 {
@@ -557,3 +593,330 @@ TEST(FixParserTests, ParseStringGroupTest2)
    ASSERT_TRUE(msg != NULL);
    ASSERT_TRUE(error == NULL);
 }
+
+//-------------------------------------------------------------------------------------------------------------------//
+TEST(FixParserTests, ParseStringViewTest)
+{
+   FIXError* error = NULL;
+   FIXParser* parser = fix_parser_create("fix_descr/fix.4.4.xml", NULL, PARSER_FLAG_CHECK_ALL, &error);
+   ASSERT_TRUE(parser != NULL);
+   ASSERT_TRUE(error == NULL);
+
+   char buff[] = "8=FIX.4.4|9=166|35=V|49=order.DEMOSUCD.80|56=demo.fxgrid|34=38|57=demo.fxgrid|"
+      "52=20131226-19:38:14.360545|262=20131226-19:38:14.360545|263=1|264=1|265=0|267=1|269=1|"
+      "146=1|55=EUR/USD|10=231|";
+   char const* stop = NULL;
+   FIXMsg* msg = fix_parser_str_to_view(parser, buff, strlen(buff), '|', &stop, &error);
+   ASSERT_TRUE(msg != NULL);
+   ASSERT_TRUE(error == NULL);
+   ASSERT_EQ(*stop, '|');
+
+   char const* val = NULL;
+   uint32_t len = 0;
+   ASSERT_EQ(fix_msg_get_string(msg, NULL, 49, &val, &len, &error), FIX_SUCCESS);
+   ASSERT_EQ(val, strstr(buff, "order.DEMOSUCD.80")); // value references input buffer
+   ASSERT_EQ(len, 17U);
+
+   FIXGroup* grp = fix_msg_get_group(msg, NULL, 146, 0, &error);
+   ASSERT_TRUE(grp != NULL);
+   ASSERT_EQ(fix_msg_get_string(msg, grp, 55, &val, &len, &error), FIX_SUCCESS);
+   ASSERT_EQ(val, strstr(buff, "EUR/USD"));
+
+   char buff1[512] = {};
+   uint32_t reqBuffLen = 0;
+   ASSERT_EQ(fix_msg_to_str(msg, '|', buff1, sizeof(buff1), &reqBuffLen, &error), FIX_SUCCESS);
+   buff1[reqBuffLen] = 0;
+   ASSERT_STREQ(buff, buff1);
+
+   // modified field is copied into message, input buffer stays untouched
+   ASSERT_EQ(fix_msg_set_string(msg, NULL, 49, "order.DEMOSUCD.81", &error), FIX_SUCCESS);
+   ASSERT_EQ(fix_msg_get_string(msg, NULL, 49, &val, &len, &error), FIX_SUCCESS);
+   ASSERT_TRUE(val < buff || val >= buff + sizeof(buff));
+   ASSERT_EQ(std::string(val, len), "order.DEMOSUCD.81");
+   ASSERT_TRUE(strstr(buff, "49=order.DEMOSUCD.80|") != NULL);
+
+   fix_msg_free(msg);
+   fix_parser_free(parser);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+TEST(FixParserTests, ParseBatchTest)
+{
+   FIXError* error = NULL;
+   FIXParser* parser = fix_parser_create("fix_descr/fix.4.4.xml", NULL, PARSER_FLAG_CHECK_ALL, &error);
+   ASSERT_TRUE(parser != NULL);
+   char msg1[] = "8=FIX.4.4\0019=228\00135=8\00149=QWERTY_12345678\00156=ABCQWE_XYZ\00134=34\00157=srv-ivanov_ii1\00152=20120716-06:00:16.230\00137=1\001"
+      "11=CL_ORD_ID_1234567\00117=FE_1_9494_1\001150=0\00139=1\0011=ZUM\00155=RTS-12.12\00154=1\00138=25\00144=135155\00159=0\00132=0\00131=0\001151=25\001"
+      "14=0\0016=0\00121=1\00158=COMMENT12\00110=240\001";
+   char msg2[] = "8=FIX.4.4\0019=228\00135=8\00149=QWERTY_22345679\00156=BBCQWE_123\00134=34\00157=srv-ivanov_ii1\00152=20120716-06:00:16.230\00137=1\001"
+      "11=CL_ORD_ID_1234567\00117=FE_1_9494_2\001150=0\00139=1\0011=ZUN\00155=RTS-03.13\00154=1\00138=25\00144=135155\00159=0\00132=0\00131=0\001151=35\001"
+      "14=0\0016=0\00121=1\00158=COMMENT15\00110=133\001";
+   std::string buff = std::string(msg1) + msg2 + msg1;
+   uint32_t const tailLen = 50;
+   buff.resize(buff.size() - tailLen); // last message is incomplete
+
+   FIXMsg* msgs[4] = {};
+   uint32_t count = 0;
+   char const* stop = NULL;
+   ASSERT_EQ(FIX_SUCCESS, fix_parser_str_to_msgs(parser, buff.data(), buff.size(), FIX_SOH, msgs, 4, &count, &stop, &error));
+   ASSERT_TRUE(error == NULL);
+   ASSERT_EQ(count, 2U);
+   ASSERT_EQ(stop, buff.data() + strlen(msg1) + strlen(msg2));
+   CHECK_STRING(msgs[0], NULL, FIXFieldTag_SenderCompID, "QWERTY_12345678");
+   CHECK_STRING(msgs[1], NULL, FIXFieldTag_SenderCompID, "QWERTY_22345679");
+   fix_msg_free(msgs[0]);
+   fix_msg_free(msgs[1]);
+
+   // array is full
+   ASSERT_EQ(FIX_SUCCESS, fix_parser_str_to_msgs(parser, buff.data(), buff.size(), FIX_SOH, msgs, 1, &count, &stop, &error));
+   ASSERT_EQ(count, 1U);
+   ASSERT_EQ(stop, buff.data() + strlen(msg1));
+   CHECK_STRING(msgs[0], NULL, FIXFieldTag_SenderCompID, "QWERTY_12345678");
+   fix_msg_free(msgs[0]);
+
+   // broken CheckSum in second message
+   buff = std::string(msg1) + msg2;
+   buff[buff.size() - 2] = '4';
+   ASSERT_EQ(FIX_FAILED, fix_parser_str_to_msgs(parser, buff.data(), buff.size(), FIX_SOH, msgs, 4, &count, &stop, &error));
+   ASSERT_TRUE(error != NULL);
+   ASSERT_EQ(fix_error_get_code(error), FIX_ERROR_INTEGRITY_CHECK);
+   fix_error_free(error);
+   ASSERT_EQ(count, 1U);
+   ASSERT_EQ(stop, buff.data() + strlen(msg1));
+   fix_msg_free(msgs[0]);
+
+   fix_parser_free(parser);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+TEST(FixParserTests, ParseProjectionTest)
+{
+   FIXError* error = NULL;
+   FIXParser* parser = fix_parser_create("fix_descr/fix.4.4.xml", NULL, PARSER_FLAG_CHECK_ALL, &error);
+   ASSERT_TRUE(parser != NULL);
+   char buff[] = "8=FIX.4.4\0019=190\00135=D\00149=QWERTY_12345678\00156=ABCQWE_XYZ\00134=34\00152=20120716-06:00:16.230\001"
+            "11=CL_ORD_ID_1234567\001453=2\001448=ID1\001447=A\001452=1\001448=ID2\001447=B\001452=2\00155=RTS-12.12\001"
+            "54=1\00160=20120716-06:00:16.230\00138=25\00140=2\00110=088\001";
+
+   FIXTagNum const unknown[] = {FIXFieldTag_ClOrdID, 12345};
+   ASSERT_EQ(FIX_FAILED, fix_parser_set_projection(parser, "D", unknown, 2, &error));
+   ASSERT_EQ(fix_error_get_code(error), FIX_ERROR_UNKNOWN_FIELD);
+   fix_error_free(error);
+   error = NULL;
+
+   // group is skipped entirely, fields after it are still found
+   FIXTagNum const tags[] = {FIXFieldTag_ClOrdID, FIXFieldTag_Symbol};
+   ASSERT_EQ(FIX_SUCCESS, fix_parser_set_projection(parser, "D", tags, 2, &error));
+   char const* stop = NULL;
+   FIXMsg* msg = fix_parser_str_to_msg(parser, buff, strlen(buff), FIX_SOH, &stop, &error);
+   ASSERT_TRUE(msg != NULL);
+   ASSERT_TRUE(error == NULL);
+   ASSERT_EQ(stop, buff + strlen(buff) - 1);
+   CHECK_STRING(msg, NULL, FIXFieldTag_MsgType, "D");
+   CHECK_STRING(msg, NULL, FIXFieldTag_ClOrdID, "CL_ORD_ID_1234567");
+   CHECK_STRING(msg, NULL, FIXFieldTag_Symbol, "RTS-12.12");
+   ASSERT_TRUE(fix_msg_get_field(msg, NULL, FIXFieldTag_SenderCompID) == NULL);
+   ASSERT_TRUE(fix_msg_get_field(msg, NULL, FIXFieldTag_OrderQty) == NULL);
+   ASSERT_TRUE(fix_msg_get_field(msg, NULL, FIXFieldTag_NoPartyIDs) == NULL);
+   fix_msg_free(msg);
+
+   // projected group is parsed with all its fields
+   FIXTagNum const groupTags[] = {FIXFieldTag_NoPartyIDs};
+   ASSERT_EQ(FIX_SUCCESS, fix_parser_set_projection(parser, "D", groupTags, 1, &error));
+   msg = fix_parser_str_to_msg(parser, buff, strlen(buff), FIX_SOH, &stop, &error);
+   ASSERT_TRUE(msg != NULL);
+   ASSERT_TRUE(fix_msg_get_field(msg, NULL, FIXFieldTag_ClOrdID) == NULL);
+   FIXGroup* group = fix_msg_get_group(msg, NULL, FIXFieldTag_NoPartyIDs, 1, &error);
+   ASSERT_TRUE(group != NULL);
+   CHECK_STRING(msg, group, FIXFieldTag_PartyID, "ID2");
+   CHECK_INT32(msg, group, FIXFieldTag_PartyRole, 2);
+   fix_msg_free(msg);
+
+   ASSERT_EQ(FIX_SUCCESS, fix_parser_reset_projection(parser, "D"));
+   ASSERT_EQ(FIX_FAILED, fix_parser_reset_projection(parser, "D"));
+   msg = fix_parser_str_to_msg(parser, buff, strlen(buff), FIX_SOH, &stop, &error);
+   ASSERT_TRUE(msg != NULL);
+   CHECK_STRING(msg, NULL, FIXFieldTag_SenderCompID, "QWERTY_12345678");
+   CHECK_DOUBLE(msg, NULL, FIXFieldTag_OrderQty, 25);
+   fix_msg_free(msg);
+
+   fix_parser_free(parser);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+TEST(FixParserTests, PeekTest)
+{
+   FIXError* error = NULL;
+   char buff[] = "8=FIX.4.4|9=228|35=8|49=QWERTY_12345678|56=ABCQWE_XYZ|34=34|57=srv-ivanov_ii1|52=20120716-06:00:16.230|37=1|"
+      "11=CL_ORD_ID_1234567|17=FE_1_9494_1|150=0|39=1|1=ZUM|55=RTS-12.12|54=1|38=25|44=135155|59=0|32=0|31=0|151=25|"
+      "14=0|6=0|21=1|58=COMMENT12|10=110|";
+   FIXTagNum const tags[] = {FIXFieldTag_MsgType, FIXFieldTag_SenderCompID, FIXFieldTag_TargetCompID, FIXFieldTag_Account,
+      FIXFieldTag_Symbol};
+   FIXFieldSpan spans[5];
+   uint32_t found = 0;
+   ASSERT_EQ(FIX_SUCCESS, fix_parser_peek(buff, strlen(buff), '|', tags, spans, 5, 0, &found, &error));
+   ASSERT_TRUE(error == NULL);
+   ASSERT_EQ(found, 5U);
+   ASSERT_EQ(std::string(spans[0].data, spans[0].len), "8");
+   ASSERT_EQ(std::string(spans[1].data, spans[1].len), "QWERTY_12345678");
+   ASSERT_EQ(std::string(spans[2].data, spans[2].len), "ABCQWE_XYZ");
+   ASSERT_EQ(std::string(spans[3].data, spans[3].len), "ZUM");
+   ASSERT_EQ(spans[4].data, strstr(buff, "RTS-12.12"));
+   ASSERT_EQ(spans[4].len, 9U);
+
+   // scanning is limited by first 10 fields, so Account and Symbol are not found
+   ASSERT_EQ(FIX_SUCCESS, fix_parser_peek(buff, strlen(buff), '|', tags, spans, 5, 10, &found, &error));
+   ASSERT_EQ(found, 3U);
+   ASSERT_TRUE(spans[2].data != NULL);
+   ASSERT_TRUE(spans[3].data == NULL);
+   ASSERT_TRUE(spans[4].data == NULL);
+
+   FIXTagNum const unknown[] = {FIXFieldTag_MsgType, 9999};
+   ASSERT_EQ(FIX_SUCCESS, fix_parser_peek(buff, strlen(buff), '|', unknown, spans, 2, 0, &found, &error));
+   ASSERT_EQ(found, 1U);
+   ASSERT_TRUE(spans[1].data == NULL);
+
+   ASSERT_EQ(FIX_FAILED, fix_parser_peek("8=FIX.4.4|9=", 12, '|', unknown, spans, 2, 0, &found, &error));
+   ASSERT_TRUE(error != NULL);
+   fix_error_free(error);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+TEST(FixParserTests, ParseIntoTest)
+{
+   FIXError* error = NULL;
+   FIXParserAttrs attrs = {512, 0, 2, 0, 2, 0};
+   FIXParser* parser = fix_parser_create("fix_descr/fix.4.4.xml", &attrs, PARSER_FLAG_CHECK_ALL, &error);
+   ASSERT_TRUE(parser != NULL);
+   char report[] = "8=FIX.4.4\0019=228\00135=8\00149=QWERTY_12345678\00156=ABCQWE_XYZ\00134=34\00157=srv-ivanov_ii1\00152=20120716-06:00:16.230\00137=1\001"
+      "11=CL_ORD_ID_1234567\00117=FE_1_9494_1\001150=0\00139=1\0011=ZUM\00155=RTS-12.12\00154=1\00138=25\00144=135155\00159=0\00132=0\00131=0\001151=25\001"
+      "14=0\0016=0\00121=1\00158=COMMENT12\00110=240\001";
+   char order[] = "8=FIX.4.4\0019=190\00135=D\00149=QWERTY_12345678\00156=ABCQWE_XYZ\00134=34\00152=20120716-06:00:16.230\001"
+            "11=CL_ORD_ID_1234567\001453=2\001448=ID1\001447=A\001452=1\001448=ID2\001447=B\001452=2\00155=RTS-12.12\001"
+            "54=1\00160=20120716-06:00:16.230\00138=25\00140=2\00110=088\001";
+
+   FIXMsg* msg = fix_msg_create(parser, "0", &error);
+   ASSERT_TRUE(msg != NULL);
+   char const* stop = NULL;
+   uint32_t usedPages = 0;
+   uint32_t usedGroups = 0;
+   for(int32_t i = 0; i < 3; ++i)
+   {
+      ASSERT_EQ(FIX_SUCCESS, fix_parser_str_to_msg_into(parser, msg, report, strlen(report), FIX_SOH, &stop, &error));
+      ASSERT_STREQ(fix_msg_get_type(msg), "8");
+      CHECK_STRING(msg, NULL, FIXFieldTag_Account, "ZUM");
+      ASSERT_TRUE(fix_msg_get_group(msg, NULL, FIXFieldTag_NoPartyIDs, 0, &error) == NULL);
+
+      ASSERT_EQ(FIX_SUCCESS, fix_parser_str_to_msg_into(parser, msg, order, strlen(order), FIX_SOH, &stop, &error));
+      ASSERT_STREQ(fix_msg_get_type(msg), "D");
+      ASSERT_TRUE(fix_msg_get_field(msg, NULL, FIXFieldTag_Account) == NULL);
+      FIXGroup* group = fix_msg_get_group(msg, NULL, FIXFieldTag_NoPartyIDs, 1, &error);
+      ASSERT_TRUE(group != NULL);
+      CHECK_STRING(msg, group, FIXFieldTag_PartyID, "ID2");
+
+      char buff[1024];
+      uint32_t reqBuffLen = 0;
+      ASSERT_EQ(FIX_SUCCESS, fix_msg_to_str(msg, FIX_SOH, buff, sizeof(buff), &reqBuffLen, &error));
+      buff[reqBuffLen] = 0;
+      ASSERT_STREQ(order, buff);
+
+      if (i == 0)
+      {
+         usedPages = parser->used_pages;
+         usedGroups = parser->used_groups;
+      }
+      else // nothing is taken from parser pools in steady state
+      {
+         ASSERT_EQ(usedPages, parser->used_pages);
+         ASSERT_EQ(usedGroups, parser->used_groups);
+      }
+   }
+
+   ASSERT_EQ(FIX_SUCCESS, fix_msg_reset(msg, &error));
+   ASSERT_STREQ(fix_msg_get_type(msg), "D");
+   CHECK_STRING(msg, NULL, FIXFieldTag_BeginString, "FIX.4.4");
+   ASSERT_TRUE(fix_msg_get_field(msg, NULL, FIXFieldTag_ClOrdID) == NULL);
+   ASSERT_TRUE(fix_msg_get_group(msg, NULL, FIXFieldTag_NoPartyIDs, 0, &error) == NULL);
+   ASSERT_EQ(usedPages, parser->used_pages);
+
+   // broken message keeps target alive
+   order[strlen(order) - 2] = '9';
+   ASSERT_EQ(FIX_FAILED, fix_parser_str_to_msg_into(parser, msg, order, strlen(order), FIX_SOH, &stop, &error));
+   ASSERT_EQ(fix_error_get_code(error), FIX_ERROR_INTEGRITY_CHECK);
+   fix_error_free(error);
+   error = NULL;
+   ASSERT_EQ(FIX_SUCCESS, fix_parser_str_to_msg_into(parser, msg, report, strlen(report), FIX_SOH, &stop, &error));
+
+   fix_msg_free(msg);
+   ASSERT_EQ(parser->used_pages, 0U);
+   ASSERT_EQ(parser->used_groups, 0U);
+   fix_parser_free(parser);
+}
+
+#ifndef WIN32
+//-------------------------------------------------------------------------------------------------------------------//
+static void* parse_in_thread(void* arg)
+{
+   FIXError* error = NULL;
+   FIXParser* parser = fix_parser_create_with_protocol((FIXProtocolDescr const*)arg, NULL, PARSER_FLAG_CHECK_ALL, &error);
+   if (!parser)
+   {
+      return (void*)1;
+   }
+   char order[] = "8=FIX.4.4\0019=190\00135=D\00149=QWERTY_12345678\00156=ABCQWE_XYZ\00134=34\00152=20120716-06:00:16.230\001"
+            "11=CL_ORD_ID_1234567\001453=2\001448=ID1\001447=A\001452=1\001448=ID2\001447=B\001452=2\00155=RTS-12.12\001"
+            "54=1\00160=20120716-06:00:16.230\00138=25\00140=2\00110=088\001";
+   intptr_t failed = 0;
+   for(int32_t i = 0; i < 10000 && !failed; ++i)
+   {
+      char const* stop = NULL;
+      FIXMsg* msg = fix_parser_str_to_msg(parser, order, strlen(order), FIX_SOH, &stop, &error);
+      FIXGroup* group = msg ? fix_msg_get_group(msg, NULL, FIXFieldTag_NoPartyIDs, 1, &error) : NULL;
+      char const* val = NULL;
+      uint32_t len = 0;
+      failed = !group || fix_msg_get_string(msg, group, FIXFieldTag_PartyID, &val, &len, &error) != FIX_SUCCESS ||
+         len != 3 || strncmp(val, "ID2", len);
+      fix_msg_free(msg);
+   }
+   fix_parser_free(parser);
+   return (void*)failed;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+TEST(FixParserTests, SharedProtocolTest)
+{
+   FIXError* error = NULL;
+   FIXProtocolDescr const* prot = fix_protocol_create("fix_descr/fix.4.4.xml", &error);
+   ASSERT_TRUE(prot != NULL);
+   ASSERT_EQ(prot->refs, 1);
+
+   FIXParser* parser = fix_parser_create_with_protocol(prot, NULL, PARSER_FLAG_CHECK_ALL, &error);
+   ASSERT_TRUE(parser != NULL);
+   ASSERT_EQ(fix_parser_get_protocol(parser), prot);
+   ASSERT_EQ(prot->refs, 2);
+
+   ASSERT_TRUE(fix_parser_create_with_protocol(NULL, NULL, PARSER_FLAG_CHECK_ALL, &error) == NULL);
+   ASSERT_EQ(fix_error_get_code(error), FIX_ERROR_INVALID_ARGUMENT);
+   fix_error_free(error);
+   error = NULL;
+
+   pthread_t threads[4];
+   for(uint32_t i = 0; i < sizeof(threads) / sizeof(threads[0]); ++i)
+   {
+      ASSERT_EQ(0, pthread_create(&threads[i], NULL, &parse_in_thread, (void*)prot));
+   }
+   for(uint32_t i = 0; i < sizeof(threads) / sizeof(threads[0]); ++i)
+   {
+      void* res = NULL;
+      ASSERT_EQ(0, pthread_join(threads[i], &res));
+      ASSERT_TRUE(res == NULL);
+   }
+   ASSERT_EQ(prot->refs, 2);
+
+   // parser keeps description alive
+   fix_protocol_free(prot);
+   ASSERT_EQ(prot->refs, 1);
+   ASSERT_STREQ(fix_parser_get_protocol_ver(parser), "FIX.4.4");
+   fix_parser_free(parser);
+}
+#endif
@@ -217,3 +217,133 @@ TEST(FIXProtocolTests, FIXProtocolTest3)
 
    fix_parser_free(p);
 }
+
+static void check_group_index(FIXFieldDescr const* group)
+{
+   for(uint32_t i = 0; i < group->group_count; ++i)
+   {
+      FIXFieldDescr const* fdescr = fix_protocol_get_group_descr(group, group->group[i].type->tag);
+      ASSERT_TRUE(fdescr != NULL);
+      ASSERT_EQ(fdescr->type->tag, group->group[i].type->tag);
+      check_group_index(&group->group[i]);
+   }
+}
+
+TEST(FIXProtocolTests, FieldIndexTest)
+{
+   FIXError* error = NULL;
+   FIXParser* p = fix_parser_create("fix_descr/fix.5.0.sp2.xml", NULL, PARSER_FLAG_CHECK_ALL, &error);
+   ASSERT_TRUE(p != NULL);
+   for(uint32_t i = 0; i < MSG_CNT; ++i)
+   {
+      for(FIXMsgDescr const* msg = p->protocol->messages[i]; msg; msg = msg->next)
+      {
+         for(uint32_t j = 0; j < msg->field_count; ++j)
+         {
+            FIXFieldDescr const* fdescr = fix_protocol_get_field_descr(msg, msg->fields[j].type->tag);
+            ASSERT_TRUE(fdescr != NULL);
+            ASSERT_EQ(fdescr->type->tag, msg->fields[j].type->tag);
+            check_group_index(&msg->fields[j]);
+         }
+         ASSERT_TRUE(fix_protocol_get_field_descr(msg, 0) == NULL);
+         ASSERT_TRUE(fix_protocol_get_field_descr(msg, 99999) == NULL);
+      }
+   }
+   fix_parser_free(p);
+
+   p = fix_parser_create("./test_data/fix4.xml", NULL, PARSER_FLAG_CHECK_ALL, &error);
+   ASSERT_TRUE(p != NULL);
+   FIXMsgDescr const* msg = fix_protocol_get_msg_descr(p, "8", &error);
+   ASSERT_TRUE(msg != NULL);
+   ASSERT_TRUE(msg->field_index.hash != NULL);
+   FIXTagNum const tags[] = {8, 9, 35, 37, 11, 5001, 9999, 10001, 20000, 10};
+   for(uint32_t i = 0; i < sizeof(tags) / sizeof(tags[0]); ++i)
+   {
+      FIXFieldDescr const* fdescr = fix_protocol_get_field_descr(msg, tags[i]);
+      ASSERT_TRUE(fdescr != NULL);
+      ASSERT_EQ(fdescr->type->tag, tags[i]);
+   }
+   ASSERT_TRUE(fix_protocol_get_field_descr(msg, 10002) == NULL);
+   ASSERT_TRUE(fix_protocol_get_field_descr(msg, 20002) == NULL);
+   ASSERT_TRUE(fix_protocol_get_field_descr(msg, 36) == NULL);
+
+   FIXFieldDescr const* group = fix_protocol_get_field_descr(msg, 10001);
+   ASSERT_EQ(group->category, FIXFieldCategory_Group);
+   ASSERT_EQ(fix_protocol_get_group_descr(group, 10002)->type->tag, 10002);
+   ASSERT_EQ(fix_protocol_get_group_descr(group, 20002)->type->tag, 20002);
+   ASSERT_EQ(fix_protocol_get_group_descr(group, 37)->type->tag, 37);
+   ASSERT_TRUE(fix_protocol_get_group_descr(group, 5001) == NULL);
+   ASSERT_TRUE(fix_protocol_get_group_descr(group, 11) == NULL);
+   fix_parser_free(p);
+}
+
+TEST(FIXProtocolTests, MsgIndexTest)
+{
+   FIXError* error = NULL;
+   FIXParser* p = fix_parser_create("fix_descr/fix.5.0.sp2.xml", NULL, PARSER_FLAG_CHECK_ALL, &error);
+   ASSERT_TRUE(p != NULL);
+   uint32_t count = 0;
+   for(uint32_t i = 0; i < MSG_CNT; ++i)
+   {
+      for(FIXMsgDescr const* msg = p->protocol->messages[i]; msg; msg = msg->next, ++count)
+      {
+         uint32_t const len = strlen(msg->type);
+         ASSERT_EQ(msg->type_key != 0, len <= MSG_TYPE_KEY_LEN);
+         FIXMsgDescr const* found = fix_protocol_find_msg_descr(p->protocol, msg->type, len);
+         ASSERT_TRUE(found != NULL);
+         ASSERT_STREQ(found->type, msg->type);
+         ASSERT_EQ(found, fix_protocol_get_msg_descr(p, msg->type, &error));
+      }
+   }
+   ASSERT_TRUE(count > 100);
+
+   char const types[] = "AE|8|";
+   ASSERT_STREQ(fix_protocol_find_msg_descr(p->protocol, types, 2)->type, "AE");
+   ASSERT_STREQ(fix_protocol_find_msg_descr(p->protocol, types + 3, 1)->type, "8");
+   ASSERT_TRUE(fix_protocol_find_msg_descr(p->protocol, types + 2, 1) == NULL);
+   ASSERT_TRUE(fix_protocol_find_msg_descr(p->protocol, "ZZZ", 3) == NULL);
+   ASSERT_TRUE(fix_protocol_find_msg_descr(p->protocol, "", 0) == NULL);
+   ASSERT_TRUE(fix_protocol_find_msg_descr(p->protocol, "UNKNOWN", 7) == NULL);
+
+   ASSERT_TRUE(fix_protocol_get_msg_descr(p, "ZZ", &error) == NULL);
+   ASSERT_EQ(fix_error_get_code(error), FIX_ERROR_UNKNOWN_MSG);
+   fix_error_free(error);
+   fix_parser_free(p);
+}
+
+TEST(FIXProtocolTests, SerializationPlanTest)
+{
+   FIXError* error = NULL;
+   FIXParser* p = fix_parser_create("fix_descr/fix.4.4.xml", NULL, PARSER_FLAG_CHECK_ALL, &error);
+   ASSERT_TRUE(p != NULL);
+   FIXMsgDescr const* msg = fix_protocol_get_msg_descr(p, "X", &error);
+   ASSERT_TRUE(msg != NULL);
+
+   FIXFieldDescr const* field = fix_protocol_get_field_descr(msg, FIXFieldTag_BodyLength);
+   ASSERT_EQ(field->emit, FIELD_EMIT_BODY_LENGTH);
+   ASSERT_EQ(std::string(field->prefix, field->prefix_len), "9=");
+
+   field = fix_protocol_get_field_descr(msg, FIXFieldTag_CheckSum);
+   ASSERT_EQ(field->emit, FIELD_EMIT_CHECKSUM);
+   ASSERT_EQ(std::string(field->prefix, field->prefix_len), "10=");
+
+   field = fix_protocol_get_field_descr(msg, FIXFieldTag_SendingTime);
+   ASSERT_EQ(field->emit, FIELD_EMIT_VALUE);
+   ASSERT_EQ(std::string(field->prefix, field->prefix_len), "52=");
+
+   FIXFieldDescr const* group = fix_protocol_get_field_descr(msg, FIXFieldTag_NoMDEntries);
+   ASSERT_EQ(group->emit, FIELD_EMIT_GROUP);
+   ASSERT_EQ(std::string(group->prefix, group->prefix_len), "268=");
+
+   field = fix_protocol_get_group_descr(group, FIXFieldTag_MDEntryPx);
+   ASSERT_EQ(field->emit, FIELD_EMIT_VALUE);
+   ASSERT_EQ(std::string(field->prefix, field->prefix_len), "270=");
+
+   for(uint32_t i = 0; i < msg->field_count; ++i)
+   {
+      char tag[FIELD_PREFIX_LEN];
+      int32_t const len = snprintf(tag, sizeof(tag), "%d=", msg->fields[i].type->tag);
+      ASSERT_EQ(std::string(msg->fields[i].prefix, msg->fields[i].prefix_len), std::string(tag, len));
+   }
+   fix_parser_free(p);
+}
@@ -0,0 +1,242 @@
+/**
+ * @file   fix_template_tests.cc
+ * @date   Created on: 10/17/2026 04:58:31 PM
+ */
+
+#include <fix_template.h>
+#include <fix_parser.h>
+#include <fix_msg.h>
+#include <fix_error.h>
+
+#include <gtest/gtest.h>
+#include <string>
+
+static FIXMsg* new_order(FIXParser* p, int32_t seqNum, char const* clOrdID, int64_t price, int64_t qty)
+{
+   FIXError* error = NULL;
+   FIXMsg* msg = fix_msg_create(p, "D", &error);
+   if (!msg ||
+       fix_msg_set_string(msg, NULL, FIXFieldTag_SenderCompID, "QWERTY_12345678", &error) != FIX_SUCCESS ||
+       fix_msg_set_string(msg, NULL, FIXFieldTag_TargetCompID, "ABCQWE_XYZ", &error) != FIX_SUCCESS ||
+       fix_msg_set_int32(msg, NULL, FIXFieldTag_MsgSeqNum, seqNum, &error) != FIX_SUCCESS ||
+       fix_msg_set_string(msg, NULL, FIXFieldTag_SendingTime, "20120716-06:00:16.230", &error) != FIX_SUCCESS ||
+       fix_msg_set_string(msg, NULL, FIXFieldTag_ClOrdID, clOrdID, &error) != FIX_SUCCESS ||
+       fix_msg_set_char(msg, NULL, FIXFieldTag_HandlInst, '1', &error) != FIX_SUCCESS ||
+       fix_msg_set_string(msg, NULL, FIXFieldTag_Symbol, "RTS-12.12", &error) != FIX_SUCCESS ||
+       fix_msg_set_char(msg, NULL, FIXFieldTag_Side, '1', &error) != FIX_SUCCESS ||
+       fix_msg_set_string(msg, NULL, FIXFieldTag_TransactTime, "20120716-06:00:16.230", &error) != FIX_SUCCESS ||
+       fix_msg_set_decimal(msg, NULL, FIXFieldTag_OrderQty, qty, 0, &error) != FIX_SUCCESS ||
+       fix_msg_set_char(msg, NULL, FIXFieldTag_OrdType, '2', &error) != FIX_SUCCESS ||
+       fix_msg_set_decimal(msg, NULL, FIXFieldTag_Price, price, -2, &error) != FIX_SUCCESS)
+   {
+      fix_error_free(error);
+      fix_msg_free(msg);
+      return NULL;
+   }
+   return msg;
+}
+
+static std::string to_str(FIXMsg* msg)
+{
+   FIXError* error = NULL;
+   char buff[1024];
+   uint32_t len = 0;
+   if (fix_msg_to_str(msg, '|', buff, sizeof(buff), &len, &error) != FIX_SUCCESS)
+   {
+      fix_error_free(error);
+      return std::string();
+   }
+   return std::string(buff, len);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+TEST(FixTemplateTests, PatchTest)
+{
+   FIXError* error = NULL;
+   FIXParser* p = fix_parser_create("fix_descr/fix.4.4.xml", NULL, PARSER_FLAG_CHECK_ALL, &error);
+   ASSERT_TRUE(p != NULL);
+
+   FIXMsg* msg = new_order(p, 1, "CL_1", 13515, 25);
+   ASSERT_TRUE(msg != NULL);
+   FIXTemplateSlot const slots[] =
+   {
+      {FIXFieldTag_MsgSeqNum, 0}, {FIXFieldTag_SendingTime, 21}, {FIXFieldTag_ClOrdID, 0},
+      {FIXFieldTag_Price, 0}, {FIXFieldTag_OrderQty, 0}
+   };
+   FIXTemplate* tmpl = fix_template_create(msg, '|', slots, sizeof(slots) / sizeof(slots[0]), &error);
+   ASSERT_TRUE(tmpl != NULL);
+
+   char const* data = NULL;
+   uint32_t len = 0;
+   ASSERT_EQ(fix_template_get_data(tmpl, &data, &len), FIX_SUCCESS);
+   ASSERT_EQ(std::string(data, len), to_str(msg));
+   fix_msg_free(msg);
+
+   // values of various lengths, including BodyLength growing from two to three digits and back
+   std::string const longID(120, 'X');
+   struct
+   {
+      int32_t seqNum;
+      char const* clOrdID;
+      int64_t price;
+      int64_t qty;
+   } const orders[] =
+   {
+      {2, "CL_2", 13520, 30},
+      {10, "CL_ORD_ID_10", 99, 1000000},
+      {11, longID.c_str(), -12345678, 1},
+      {12345, "C", 0, 25}
+   };
+   for(uint32_t i = 0; i < sizeof(orders) / sizeof(orders[0]); ++i)
+   {
+      ASSERT_EQ(fix_template_set_int64(tmpl, 0, orders[i].seqNum, &error), FIX_SUCCESS);
+      ASSERT_EQ(fix_template_set_string(tmpl, 1, "20120716-06:00:16.230", 21, &error), FIX_SUCCESS);
+      ASSERT_EQ(fix_template_set_string(tmpl, 2, orders[i].clOrdID, strlen(orders[i].clOrdID), &error), FIX_SUCCESS);
+      ASSERT_EQ(fix_template_set_decimal(tmpl, 3, orders[i].price, -2, &error), FIX_SUCCESS);
+      ASSERT_EQ(fix_template_set_decimal(tmpl, 4, orders[i].qty, 0, &error), FIX_SUCCESS);
+      ASSERT_EQ(fix_template_get_data(tmpl, &data, &len), FIX_SUCCESS);
+
+      msg = new_order(p, orders[i].seqNum, orders[i].clOrdID, orders[i].price, orders[i].qty);
+      ASSERT_TRUE(msg != NULL);
+      ASSERT_EQ(std::string(data, len), to_str(msg));
+      fix_msg_free(msg);
+
+      char const* stop = NULL;
+      msg = fix_parser_str_to_msg(p, data, len, '|', &stop, &error);
+      ASSERT_TRUE(msg != NULL);
+      fix_msg_free(msg);
+   }
+
+   ASSERT_EQ(fix_template_set_string(tmpl, 1, "20120716-06:00:16", 17, &error), FIX_FAILED);
+   ASSERT_EQ(fix_error_get_code(error), FIX_ERROR_WRONG_FIELD_VALUE);
+   fix_error_free(error);
+
+   ASSERT_EQ(fix_template_set_int64(tmpl, 5, 1, &error), FIX_FAILED);
+   ASSERT_EQ(fix_error_get_code(error), FIX_ERROR_INVALID_ARGUMENT);
+   fix_error_free(error);
+
+   fix_template_free(tmpl);
+   fix_parser_free(p);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+TEST(FixTemplateTests, FixedWidthNumberTest)
+{
+   FIXError* error = NULL;
+   FIXParser* p = fix_parser_create("fix_descr/fix.4.4.xml", NULL, PARSER_FLAG_CHECK_ALL, &error);
+   ASSERT_TRUE(p != NULL);
+
+   FIXMsg* msg = new_order(p, 10000000, "CL_1", -13515, 25);
+   ASSERT_TRUE(msg != NULL);
+   FIXTemplateSlot const slots[] = {{FIXFieldTag_MsgSeqNum, 8}, {FIXFieldTag_Price, 7}};
+   FIXTemplate* tmpl = fix_template_create(msg, '|', slots, 2, &error);
+   ASSERT_TRUE(tmpl != NULL);
+   fix_msg_free(msg);
+
+   ASSERT_EQ(fix_template_set_int64(tmpl, 0, 35, &error), FIX_SUCCESS);
+   ASSERT_EQ(fix_template_set_decimal(tmpl, 1, -510, -2, &error), FIX_SUCCESS);
+   char const* data = NULL;
+   uint32_t len = 0;
+   ASSERT_EQ(fix_template_get_data(tmpl, &data, &len), FIX_SUCCESS);
+   std::string const str(data, len);
+   ASSERT_NE(str.find("|34=00000035|"), std::string::npos);
+   ASSERT_NE(str.find("|44=-005.10|"), std::string::npos);
+
+   char const* stop = NULL;
+   msg = fix_parser_str_to_msg(p, data, len, '|', &stop, &error);
+   ASSERT_TRUE(msg != NULL);
+   int64_t seqNum = 0;
+   ASSERT_EQ(fix_msg_get_int64(msg, NULL, FIXFieldTag_MsgSeqNum, &seqNum, &error), FIX_SUCCESS);
+   ASSERT_EQ(seqNum, 35);
+   int64_t mantissa = 0;
+   int32_t exponent = 0;
+   ASSERT_EQ(fix_msg_get_decimal(msg, NULL, FIXFieldTag_Price, &mantissa, &exponent, &error), FIX_SUCCESS);
+   ASSERT_EQ(mantissa, -510);
+   ASSERT_EQ(exponent, -2);
+   fix_msg_free(msg);
+
+   ASSERT_EQ(fix_template_set_int64(tmpl, 0, 123456789, &error), FIX_FAILED);
+   ASSERT_EQ(fix_error_get_code(error), FIX_ERROR_WRONG_FIELD_VALUE);
+   fix_error_free(error);
+
+   fix_template_free(tmpl);
+   fix_parser_free(p);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+TEST(FixTemplateTests, WrongSlotsTest)
+{
+   FIXError* error = NULL;
+   FIXParser* p = fix_parser_create("fix_descr/fix.4.4.xml", NULL, PARSER_FLAG_CHECK_ALL, &error);
+   ASSERT_TRUE(p != NULL);
+   FIXMsg* msg = new_order(p, 1, "CL_1", 13515, 25);
+   ASSERT_TRUE(msg != NULL);
+
+   struct
+   {
+      FIXTemplateSlot slot;
+      FIXErrCode code;
+   } const wrong[] =
+   {
+      {{FIXFieldTag_BodyLength, 0}, FIX_ERROR_FIELD_HAS_WRONG_TYPE},
+      {{FIXFieldTag_BeginString, 0}, FIX_ERROR_FIELD_HAS_WRONG_TYPE},
+      {{FIXFieldTag_CheckSum, 0}, FIX_ERROR_FIELD_HAS_WRONG_TYPE},
+      {{FIXFieldTag_NoPartyIDs, 0}, FIX_ERROR_FIELD_HAS_WRONG_TYPE},
+      {{FIXFieldTag_MDEntryPx, 0}, FIX_ERROR_UNKNOWN_FIELD},
+      {{FIXFieldTag_StopPx, 0}, FIX_ERROR_FIELD_NOT_FOUND},
+      {{FIXFieldTag_ClOrdID, 5}, FIX_ERROR_WRONG_FIELD_VALUE}
+   };
+   for(uint32_t i = 0; i < sizeof(wrong) / sizeof(wrong[0]); ++i)
+   {
+      ASSERT_TRUE(fix_template_create(msg, '|', &wrong[i].slot, 1, &error) == NULL) << wrong[i].slot.tag;
+      ASSERT_EQ(fix_error_get_code(error), wrong[i].code) << wrong[i].slot.tag;
+      fix_error_free(error);
+   }
+
+   FIXTemplateSlot const twice[] = {{FIXFieldTag_ClOrdID, 0}, {FIXFieldTag_ClOrdID, 0}};
+   ASSERT_TRUE(fix_template_create(msg, '|', twice, 2, &error) == NULL);
+   ASSERT_EQ(fix_error_get_code(error), FIX_ERROR_INVALID_ARGUMENT);
+   fix_error_free(error);
+
+   fix_msg_free(msg);
+   fix_parser_free(p);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+TEST(FixTemplateTests, WrongValuesTest)
+{
+   FIXError* error = NULL;
+   FIXParser* p = fix_parser_create("fix_descr/fix.4.4.xml", NULL, PARSER_FLAG_CHECK_ALL, &error);
+   ASSERT_TRUE(p != NULL);
+   FIXMsg* msg = new_order(p, 1, "CL_1", 13515, 25);
+   ASSERT_TRUE(msg != NULL);
+   FIXTemplateSlot const slots[] = {{FIXFieldTag_ClOrdID, 0}, {FIXFieldTag_SendingTime, 21}};
+   FIXTemplate* tmpl = fix_template_create(msg, '|', slots, 2, &error);
+   ASSERT_TRUE(tmpl != NULL);
+   std::string const sent = to_str(msg);
+   fix_msg_free(msg);
+
+   struct
+   {
+      uint32_t slot;
+      char const* val;
+   } const wrong[] =
+   {
+      {0, ""}, {0, "CL|2"}, {0, "|"}, {1, "20120716|06:00:16.230"}
+   };
+   for(uint32_t i = 0; i < sizeof(wrong) / sizeof(wrong[0]); ++i)
+   {
+      ASSERT_EQ(fix_template_set_string(tmpl, wrong[i].slot, wrong[i].val, strlen(wrong[i].val), &error), FIX_FAILED) << i;
+      ASSERT_EQ(fix_error_get_code(error), FIX_ERROR_WRONG_FIELD_VALUE) << i;
+      fix_error_free(error);
+   }
+
+   // rejected values leave template untouched
+   char const* data = NULL;
+   uint32_t len = 0;
+   ASSERT_EQ(fix_template_get_data(tmpl, &data, &len), FIX_SUCCESS);
+   ASSERT_EQ(std::string(data, len), sent);
+
+   fix_template_free(tmpl);
+   fix_parser_free(p);
+}
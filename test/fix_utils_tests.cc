@@ -10,6 +10,8 @@ extern "C"
 #include <fix_types.h>
 }
 #include <gtest/gtest.h>
+#include <math.h>
+#include <stdlib.h>
 
 TEST(FixUtilsTests, i64toa_Test)
 {
@@ -36,6 +38,45 @@ TEST(FixUtilsTests, i64toa_Test)
    char buff5[10] = {"AAAAAAAAA"};
    ASSERT_EQ(fix_utils_i64toa(-37, buff5, 7, '0'), 7);
    ASSERT_STREQ("-000037AA", buff5);
+
+   char buff6[24] = {};
+   ASSERT_EQ(fix_utils_i64toa(0, buff6, sizeof(buff6), 0), 1);
+   ASSERT_STREQ("0", buff6);
+
+   char buff7[24] = {};
+   ASSERT_EQ(fix_utils_i64toa(INT64_MAX, buff7, sizeof(buff7), 0), 19);
+   ASSERT_STREQ("9223372036854775807", buff7);
+
+   char buff8[24] = {};
+   ASSERT_EQ(fix_utils_i64toa(INT64_MIN, buff8, sizeof(buff8), 0), 20);
+   ASSERT_STREQ("-9223372036854775808", buff8);
+
+   char buff9[10] = {"AAAAAAAAA"};
+   ASSERT_EQ(fix_utils_i64toa(1234567, buff9, 3, '0'), 7);
+   ASSERT_STREQ("123AAAAAA", buff9);
+
+   char buff10[10] = {"AAAAAAAAA"};
+   ASSERT_EQ(fix_utils_i64toa(-5, buff10, 0, 0), 2);
+   ASSERT_STREQ("AAAAAAAAA", buff10);
+
+   char buff11[4] = {};
+   ASSERT_EQ(fix_utils_i64toa(7, buff11, 3, '0'), 3); // CheckSum
+   ASSERT_STREQ("007", buff11);
+}
+
+TEST(FixUtilsTests, numdigits_Test)
+{
+   ASSERT_EQ(fix_utils_numdigits(0), 1);
+   ASSERT_EQ(fix_utils_numdigits(-7), 1);
+   ASSERT_EQ(fix_utils_numdigits(INT64_MAX), 19);
+   ASSERT_EQ(fix_utils_numdigits(INT64_MIN), 19);
+   int64_t pow = 1;
+   for(int32_t nd = 1; nd < 19; ++nd, pow *= 10)
+   {
+      ASSERT_EQ(fix_utils_numdigits(pow), nd);
+      ASSERT_EQ(fix_utils_numdigits(pow * 10 - 1), nd);
+      ASSERT_EQ(fix_utils_numdigits(-pow), nd);
+   }
 }
 
 TEST(FixUtilsTests, dtoa_Test)
@@ -63,6 +104,74 @@ TEST(FixUtilsTests, dtoa_Test)
    char buff5[10] = {"AAAAAAAAA"};
    ASSERT_EQ(fix_utils_dtoa(-3.12, buff5, 1), 5);
    ASSERT_STREQ("-AAAAAAAA", buff5);
+
+   // shortest representation, which is read back to the same value, without exponent
+   char buff6[FIX_DTOA_BUFF_LEN] = {};
+   ASSERT_EQ(fix_utils_dtoa(0.1, buff6, sizeof(buff6)), 3);
+   ASSERT_STREQ("0.1", buff6);
+
+   char buff7[FIX_DTOA_BUFF_LEN] = {};
+   ASSERT_EQ(fix_utils_dtoa(1e20, buff7, sizeof(buff7)), 21);
+   ASSERT_STREQ("100000000000000000000", buff7);
+
+   char buff8[FIX_DTOA_BUFF_LEN] = {};
+   ASSERT_EQ(fix_utils_dtoa(1.0 / 3, buff8, sizeof(buff8)), 18);
+   ASSERT_STREQ("0.3333333333333333", buff8);
+
+   char buff9[FIX_DTOA_BUFF_LEN] = {};
+   ASSERT_EQ(fix_utils_dtoa(-0.00125, buff9, sizeof(buff9)), 8);
+   ASSERT_STREQ("-0.00125", buff9);
+
+   char buff10[FIX_DTOA_BUFF_LEN] = {};
+   ASSERT_EQ(fix_utils_dtoa(-0.0, buff10, sizeof(buff10)), 1);
+   ASSERT_STREQ("0", buff10);
+
+   double const extremes[] = {5e-324, 2.2250738585072014e-308, 1.7976931348623157e308, 0.30000000000000004};
+   for(uint32_t i = 0; i < sizeof(extremes) / sizeof(extremes[0]); ++i)
+   {
+      char buff11[FIX_DTOA_BUFF_LEN] = {};
+      int32_t const len = fix_utils_dtoa(extremes[i], buff11, sizeof(buff11) - 1);
+      ASSERT_LT(len, FIX_DTOA_BUFF_LEN);
+      ASSERT_EQ(strtod(buff11, NULL), extremes[i]);
+   }
+
+   char buff12[10] = {"AAAAAAAAA"};
+   ASSERT_EQ(fix_utils_dtoa(HUGE_VAL, buff12, sizeof(buff12)), 0);
+   ASSERT_EQ(fix_utils_dtoa(NAN, buff12, sizeof(buff12)), 0);
+   ASSERT_STREQ("AAAAAAAAA", buff12);
+}
+
+TEST(FixUtilsTests, dtoa_fixed_Test)
+{
+   struct
+   {
+      double val;
+      uint32_t precision;
+      char const* str;
+   } const cases[] =
+   {
+      {135.15, 2, "135.15"},
+      {135.1, 2, "135.10"},
+      {0.1 + 0.2, 2, "0.30"},
+      {1.005, 2, "1.01"},
+      {9.996, 2, "10.00"},
+      {0.006, 2, "0.01"},
+      {-0.001, 2, "0.00"},
+      {-2.5, 0, "-3"},
+      {0.0, 3, "0.000"},
+      {25.0, 0, "25"},
+      {1e20, 1, "100000000000000000000.0"}
+   };
+   for(uint32_t i = 0; i < sizeof(cases) / sizeof(cases[0]); ++i)
+   {
+      char buff[FIX_DTOA_BUFF_LEN] = {};
+      ASSERT_EQ(fix_utils_dtoa_fixed(cases[i].val, cases[i].precision, buff, sizeof(buff)), (int32_t)strlen(cases[i].str));
+      ASSERT_STREQ(cases[i].str, buff);
+   }
+
+   char buff[10] = {"AAAAAAAAA"};
+   ASSERT_EQ(fix_utils_dtoa_fixed(-135.15, 3, buff, 4), 8);
+   ASSERT_STREQ("-135AAAAA", buff);
 }
 
 
@@ -305,6 +414,93 @@ TEST(FixUtilsTests, atod_Test)
    }
 }
 
+TEST(FixUtilsTests, atodec_Test)
+{
+   struct
+   {
+      char const* str;
+      int64_t mantissa;
+      int32_t exponent;
+   } const cases[] =
+   {
+      {"135.15", 13515, -2},
+      {"135.10", 13510, -2},
+      {"-0.00125", -125, -5},
+      {"23.", 23, 0},
+      {".5", 5, -1},
+      {"0", 0, 0},
+      {"9223372036854775807", INT64_MAX, 0},
+      {"-9223372036854775808", INT64_MIN, 0},
+      {"922337203685477580.7", INT64_MAX, -1},
+      {"1.000000000000000000000", 1000000000000000000, -18} // zeros, which don't fit, are dropped
+   };
+   for(uint32_t i = 0; i < sizeof(cases) / sizeof(cases[0]); ++i)
+   {
+      int64_t mantissa = 0;
+      int32_t exponent = 0;
+      int32_t cnt = 0;
+      ASSERT_EQ(fix_utils_atodec(cases[i].str, strlen(cases[i].str), 0, &mantissa, &exponent, &cnt), FIX_SUCCESS);
+      ASSERT_EQ(cnt, (int32_t)strlen(cases[i].str));
+      ASSERT_EQ(mantissa, cases[i].mantissa);
+      ASSERT_EQ(exponent, cases[i].exponent);
+   }
+
+   char const* wrong[] = {"", "-", ".", "1.2.3", "12a", "9223372036854775808", "0.12345678901234567891", "1e5"};
+   for(uint32_t i = 0; i < sizeof(wrong) / sizeof(wrong[0]); ++i)
+   {
+      int64_t mantissa = 0;
+      int32_t exponent = 0;
+      int32_t cnt = 0;
+      ASSERT_NE(fix_utils_atodec(wrong[i], strlen(wrong[i]), 0, &mantissa, &exponent, &cnt), FIX_SUCCESS) << wrong[i];
+   }
+
+   {
+      char str[] = "12.5\0014=";
+      int64_t mantissa = 0;
+      int32_t exponent = 0;
+      int32_t cnt = 0;
+      ASSERT_EQ(fix_utils_atodec(str, strlen(str), 1, &mantissa, &exponent, &cnt), FIX_SUCCESS);
+      ASSERT_EQ(cnt, 4);
+      ASSERT_EQ(mantissa, 125);
+      ASSERT_EQ(exponent, -1);
+      ASSERT_EQ(fix_utils_atodec(str, 4, 1, &mantissa, &exponent, &cnt), FIX_ERROR_NO_MORE_DATA);
+   }
+}
+
+TEST(FixUtilsTests, dectoa_Test)
+{
+   struct
+   {
+      int64_t mantissa;
+      int32_t exponent;
+      char const* str;
+   } const cases[] =
+   {
+      {13515, -2, "135.15"},
+      {13510, -2, "135.10"},
+      {-125, -5, "-0.00125"},
+      {0, -2, "0.00"},
+      {0, 3, "0"},
+      {25, 3, "25000"},
+      {INT64_MIN, 0, "-9223372036854775808"},
+      {INT64_MIN, -18, "-9.223372036854775808"},
+      {INT64_MAX, 18, "9223372036854775807000000000000000000"},
+      {1, -18, "0.000000000000000001"}
+   };
+   for(uint32_t i = 0; i < sizeof(cases) / sizeof(cases[0]); ++i)
+   {
+      char buff[FIX_DECTOA_BUFF_LEN] = {};
+      ASSERT_EQ(fix_utils_dectoa(cases[i].mantissa, cases[i].exponent, buff, sizeof(buff)), (int32_t)strlen(cases[i].str));
+      ASSERT_STREQ(cases[i].str, buff);
+   }
+
+   char buff[10] = {"AAAAAAAAA"};
+   ASSERT_EQ(fix_utils_dectoa(1, 19, buff, sizeof(buff)), 0);
+   ASSERT_EQ(fix_utils_dectoa(1, -19, buff, sizeof(buff)), 0);
+   ASSERT_EQ(fix_utils_dectoa(-13515, -2, buff, 4), 7);
+   ASSERT_STREQ("-135AAAAA", buff);
+}
+
 TEST(FixUtilsTests, MakePath)
 {
    char path[2024];
@@ -328,3 +524,59 @@ TEST(FixUtilsTests, MakePath)
    ASSERT_EQ(fix_utils_make_path("../../test/fix.4.4.xml", "./fixt.1.1.xml", path3, sizeof(path3)), FIX_SUCCESS);
    ASSERT_STREQ(path, "./fixt.1.1.xml");
 }
+
+TEST(FixUtilsTests, FindCharTest)
+{
+   int32_t const level = fix_utils_get_simd_level();
+   char buff[256];
+   for(int32_t simd = FIX_SIMD_NONE; simd <= FIX_SIMD_AVX2; ++simd)
+   {
+      fix_utils_set_simd_level(simd);
+      for(uint32_t offset = 0; offset < 40; ++offset)
+      {
+         for(uint32_t pos = 0; pos < 100; ++pos)
+         {
+            memset(buff, 'A', sizeof(buff));
+            buff[offset + pos] = '|';
+            buff[offset + pos + 10] = '|';
+            ASSERT_EQ(fix_utils_find_char(buff + offset, pos + 1, '|'), buff + offset + pos);
+            ASSERT_EQ(fix_utils_find_char(buff + offset, 100, '|'), buff + offset + pos);
+            ASSERT_TRUE(fix_utils_find_char(buff + offset, pos, '|') == NULL);
+         }
+      }
+      memset(buff, 'A', sizeof(buff));
+      buff[0] = '|';
+      ASSERT_TRUE(fix_utils_find_char(buff + 1, sizeof(buff) - 1, '|') == NULL);
+      ASSERT_TRUE(fix_utils_find_char(buff, 0, '|') == NULL);
+   }
+   fix_utils_set_simd_level(level);
+}
+
+TEST(FixUtilsTests, ChecksumTest)
+{
+   int32_t const level = fix_utils_get_simd_level();
+   char buff[300];
+   for(uint32_t i = 0; i < sizeof(buff); ++i)
+   {
+      buff[i] = (char)(i * 7 + 3);
+   }
+   for(int32_t simd = FIX_SIMD_NONE; simd <= FIX_SIMD_AVX2; ++simd)
+   {
+      fix_utils_set_simd_level(simd);
+      for(uint32_t offset = 0; offset < 40; ++offset)
+      {
+         for(uint32_t len = 0; len < sizeof(buff) - offset; ++len)
+         {
+            uint32_t sum = 0;
+            for(uint32_t i = 0; i < len; ++i)
+            {
+               sum += (unsigned char)buff[offset + i];
+            }
+            ASSERT_EQ(fix_utils_checksum(buff + offset, len), sum % 256);
+         }
+      }
+      char const msg[] = "8=FIX.4.4\0019=5\00135=0\001";
+      ASSERT_EQ(fix_utils_checksum(msg, sizeof(msg) - 1), 163U);
+   }
+   fix_utils_set_simd_level(level);
+}